@@ -27,6 +27,11 @@
 #include <lclibrary/algorithms/euler_tour.h>
 #include <lclibrary/algorithms/connected_components.h>
 #include <lclibrary/algorithms/apsp_floyd_warshall.h>
+#include <lclibrary/algorithms/apsp_dijkstra.h>
+#include <lclibrary/algorithms/apsp_lazy.h>
+#include <lclibrary/algorithms/apsp_terminals.h>
+#include <lclibrary/algorithms/apsp_contraction_hierarchy.h>
+#include <lclibrary/algorithms/apsp.h>
 #include <lclibrary/algorithms/atsp_held_karp.h>
 #include <lclibrary/algorithms/required_graph.h>
 #include <lclibrary/algorithms/matching.h>
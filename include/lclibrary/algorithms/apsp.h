@@ -0,0 +1,94 @@
+/**
+ * This file is part of the LineCoverage-library.
+ * The file contains the function to create the all pair shortest paths backend selected in APSP_Options
+ *
+ * TODO:
+ *
+ * @author Saurav Agarwal
+ * @contact sagarw10@uncc.edu
+ * @contact agr.saurav1@gmail.com
+ * Repository: https://github.com/UNCCharlotte-Robotics/LineCoverage-library
+ *
+ * Copyright (C) 2020--2022 University of North Carolina at Charlotte.
+ * The LineCoverage-library is owned by the University of North Carolina at Charlotte and is protected by United States copyright laws and applicable international treaties and/or conventions.
+ *
+ * The LineCoverage-library is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * DISCLAIMER OF WARRANTIES: THE SOFTWARE IS PROVIDED "AS-IS" WITHOUT WARRANTY OF ANY KIND INCLUDING ANY WARRANTIES OF PERFORMANCE OR MERCHANTABILITY OR FITNESS FOR A PARTICULAR USE OR PURPOSE OR OF NON-INFRINGEMENT. YOU BEAR ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE SOFTWARE OR HARDWARE.
+ *
+ * SUPPORT AND MAINTENANCE: No support, installation, or training is provided.
+ *
+ * You should have received a copy of the GNU General Public License along with LineCoverage-library. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LCLIBRARY_ALGORITHMS_APSP_FACTORY_H_
+#define LCLIBRARY_ALGORITHMS_APSP_FACTORY_H_
+
+#include <lclibrary/core/graph.h>
+#include <lclibrary/algorithms/apsp_base.h>
+#include <lclibrary/algorithms/apsp_floyd_warshall.h>
+#include <lclibrary/algorithms/apsp_dijkstra.h>
+#include <lclibrary/algorithms/apsp_lazy.h>
+#include <lclibrary/algorithms/apsp_terminals.h>
+#include <lclibrary/algorithms/apsp_contraction_hierarchy.h>
+#include <memory>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <unistd.h>
+
+namespace lclibrary {
+
+	inline APSP_Options::Backend SelectAPSPBackend(const std::shared_ptr <const Graph> &g, const bool compute_demand, const APSP_Options &options) {
+		if(options.backend != APSP_Options::automatic) {
+			return options.backend;
+		}
+		/* Keep at least half of the physical memory for the solvers */
+		double physical_bytes = double(sysconf(_SC_PHYS_PAGES)) * sysconf(_SC_PAGE_SIZE);
+		std::vector <size_t> terminals;
+		GetTerminalVertices(g, terminals);
+		double num_terminals = terminals.size();
+		double terminal_matrix_bytes = num_terminals * num_terminals * sizeof(double) * (compute_demand ? 2 : 1);
+		if(2 * terminals.size() <= g->GetN() and (physical_bytes <= 0 or terminal_matrix_bytes <= physical_bytes / 2)) {
+			return APSP_Options::terminals;
+		}
+		const double cost_bytes = options.single_precision ? sizeof(float) : sizeof(double);
+		double matrix_bytes = double(g->GetN()) * g->GetN() * (cost_bytes + 2 * sizeof(uint32_t) + (compute_demand and not options.lazy_demand ? cost_bytes : 0));
+		if(physical_bytes > 0 and matrix_bytes > physical_bytes / 2) {
+			return APSP_Options::contraction_hierarchy;
+		}
+		/* Dijkstra from every vertex takes about n m log(n) heap operations against n^3 relaxations for Floyd-Warshall, whose inner loop is several times cheaper */
+		double n = g->GetN();
+		double num_arcs = 2. * (g->GetM() + g->GetMnr());
+		if(4 * num_arcs * std::log2(n + 1) < n * n) {
+			return APSP_Options::dijkstra;
+		}
+		return APSP_Options::floyd_warshall;
+	}
+
+	/* APSP_Deadheading() is not called */
+	inline std::shared_ptr <APSP> CreateAPSP(const std::shared_ptr <const Graph> &g, const bool compute_demand, const APSP_Options &options = APSP_Options()) {
+		switch(SelectAPSPBackend(g, compute_demand, options)) {
+			case APSP_Options::dijkstra:
+				return std::make_shared <APSP_Dijkstra>(g, compute_demand, options);
+			case APSP_Options::lazy:
+				return std::make_shared <APSP_Lazy>(g, compute_demand, options);
+			case APSP_Options::terminals:
+				return std::make_shared <APSP_Terminals>(g, compute_demand, options);
+			case APSP_Options::contraction_hierarchy:
+				return std::make_shared <APSP_ContractionHierarchy>(g, compute_demand, options);
+			default:
+				if(not APSP_FloydWarshall::IsSupported(g)) {
+					std::cerr << "Graph too large for APSP_FloydWarshall, using APSP_Dijkstra\n";
+					return std::make_shared <APSP_Dijkstra>(g, compute_demand, options);
+				}
+				if(options.single_precision) {
+					return std::make_shared <APSP_FloydWarshallFloat>(g, compute_demand, options);
+				}
+				return std::make_shared <APSP_FloydWarshall>(g, compute_demand, options);
+		}
+	}
+
+} // namespace lclibrary
+
+#endif /* LCLIBRARY_ALGORITHMS_APSP_FACTORY_H_ */
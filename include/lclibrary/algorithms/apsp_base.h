@@ -24,13 +24,90 @@
 #ifndef LCLIBRARY_ALGORITHMS_APSP_H_
 #define LCLIBRARY_ALGORITHMS_APSP_H_
 
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+#include <lclibrary/core/constants.h>
 #include <lclibrary/core/edge.h>
+#include <lclibrary/utils/memory_footprint.h>
+
 namespace lclibrary {
 
+struct APSP_Options {
+	/* automatic uses terminals when few vertices are incident to required edges or depots, otherwise chooses between Floyd-Warshall and Dijkstra from the number of vertices and edges, and falls back to contraction_hierarchy if the n x n matrices do not fit in memory */
+	enum Backend {automatic, floyd_warshall, dijkstra, lazy, terminals, contraction_hierarchy} backend = automatic;
+	size_t num_threads = 0; /* 0 uses all hardware threads */
+	size_t cache_memory_mb = 1024; /* Row cache of the lazy backend */
+	bool single_precision = false; /* Floyd-Warshall stores float instead of double matrices */
+	std::string cache_dir; /* Directory of the on-disk cache of Floyd-Warshall, Dijkstra and terminals results; empty disables the cache */
+	uint64_t cost_fingerprint = 0; /* Identifies the cost function and its parameters in the cache key */
+	bool lazy_demand = false; /* Floyd-Warshall and Dijkstra do not store the demand matrix; the demand of a pair is summed along its path when first queried */
+};
+
+/* Demands of vertex pairs summed along their paths by backends with lazy_demand. Shared by the threads querying the APSP. */
+class APSP_DemandMemo {
+	std::unordered_map <uint64_t, double> demands_;
+	mutable std::mutex mutex_;
+
+	public:
+	bool Find(const uint64_t key, double &demand) const {
+		std::lock_guard <std::mutex> lock(mutex_);
+		auto it = demands_.find(key);
+		if(it == demands_.end()) {
+			return false;
+		}
+		demand = it->second;
+		return true;
+	}
+
+	void Insert(const uint64_t key, const double demand) {
+		std::lock_guard <std::mutex> lock(mutex_);
+		demands_.emplace(key, demand);
+	}
+
+	void Clear() {
+		std::lock_guard <std::mutex> lock(mutex_);
+		demands_.clear();
+	}
+
+	size_t MemoryFootprint() const {
+		std::lock_guard <std::mutex> lock(mutex_);
+		return HashMapBytes(demands_);
+	}
+};
+
 class APSP {
+	protected:
+		/* Appends the edge as a deadheading edge in the direction of traversal */
+		static void AddDeadheadEdge(std::vector < Edge > &edge_list, const Edge *e, const bool is_rev) {
+			Edge new_edge = *e;
+			new_edge.SetReq(kIsNotRequired);
+			if(is_rev) {
+				new_edge.SetCost(e->GetReverseDeadheadCost());
+				new_edge.Reverse();
+			}
+			else {
+				new_edge.SetCost(e->GetDeadheadCost());
+			}
+			edge_list.push_back(new_edge);
+		}
+
 	public:
+		virtual bool APSP_Deadheading() = 0;
 		virtual void GetPath(std::vector < Edge > &, const size_t, const size_t) const = 0;
 		virtual double GetCost(const size_t, const size_t) const = 0;
+		/* Backends that do not compute demands return NaN */
+		virtual double GetDemand(const size_t, const size_t) const { return kDoubleNaN; }
+		/* Call after the deadheading costs or demands of edges of the graph changed, e.g. after ComputeAllEdgeCosts() with a new wind or a closed road. Only the shortest paths affected by the changes are computed again. Backends without incremental updates return kFail; construct a new APSP instead. */
+		virtual bool UpdateDeadheadCosts() {
+			std::cerr << "Incremental update not supported by this APSP\n";
+			return kFail;
+		}
+		/* Bytes held by the matrices and search structures of the backend. Cache files mapped into memory are not counted; the kernel can drop their pages. */
+		virtual size_t MemoryFootprint() const { return 0; }
 		virtual ~APSP() {};
 };
 
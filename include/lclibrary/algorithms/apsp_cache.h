@@ -0,0 +1,212 @@
+/**
+ * This file is part of the LineCoverage-library.
+ * The file contains the persistent on-disk cache of all pair shortest path matrices
+ *
+ * TODO:
+ *
+ * @author Saurav Agarwal
+ * @contact sagarw10@uncc.edu
+ * @contact agr.saurav1@gmail.com
+ * Repository: https://github.com/UNCCharlotte-Robotics/LineCoverage-library
+ *
+ * Copyright (C) 2020--2022 University of North Carolina at Charlotte.
+ * The LineCoverage-library is owned by the University of North Carolina at Charlotte and is protected by United States copyright laws and applicable international treaties and/or conventions.
+ *
+ * The LineCoverage-library is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * DISCLAIMER OF WARRANTIES: THE SOFTWARE IS PROVIDED "AS-IS" WITHOUT WARRANTY OF ANY KIND INCLUDING ANY WARRANTIES OF PERFORMANCE OR MERCHANTABILITY OR FITNESS FOR A PARTICULAR USE OR PURPOSE OR OF NON-INFRINGEMENT. YOU BEAR ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE SOFTWARE OR HARDWARE.
+ *
+ * SUPPORT AND MAINTENANCE: No support, installation, or training is provided.
+ *
+ * You should have received a copy of the GNU General Public License along with LineCoverage-library. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LCLIBRARY_ALGORITHMS_APSP_CACHE_H_
+#define LCLIBRARY_ALGORITHMS_APSP_CACHE_H_
+
+#include <lclibrary/core/constants.h>
+#include <lclibrary/core/graph.h>
+#include <lclibrary/algorithms/apsp_base.h>
+#include <lclibrary/utils/fingerprint.h>
+#include <lclibrary/utils/mapped_file.h>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+#include <unistd.h>
+
+namespace lclibrary {
+
+	/* Identifies the vertices, edges, deadheading costs and demands, in order */
+	inline uint64_t GraphFingerprint(const std::shared_ptr <const Graph> &g) {
+		Fingerprint fp;
+		fp.Add(g->GetN());
+		for(size_t i = 0; i < g->GetN(); ++i) {
+			fp.Add(g->GetVertexID(i));
+		}
+		for(bool req:{kIsRequired, kIsNotRequired}) {
+			size_t num_edges = req == kIsRequired ? g->GetM() : g->GetMnr();
+			fp.Add(num_edges);
+			for(size_t i = 0; i < num_edges; ++i) {
+				const Edge *e = g->GetEdge(i, req);
+				fp.Add(e->GetTailVertexID());
+				fp.Add(e->GetHeadVertexID());
+				fp.Add(g->GetDeadheadCost(i, req));
+				fp.Add(g->GetReverseDeadheadCost(i, req));
+				fp.Add(g->GetDeadheadDemand(i, req));
+				fp.Add(g->GetReverseDeadheadDemand(i, req));
+			}
+		}
+		return fp.Get();
+	}
+
+	/* Identifies the vertex subset over which a backend stores its matrices, e.g. the terminals */
+	inline uint64_t VertexSubsetFingerprint(const std::vector <size_t> &vertices) {
+		Fingerprint fp;
+		fp.Add(vertices.size());
+		fp.Add(vertices.data(), vertices.size() * sizeof(size_t));
+		return fp.Get();
+	}
+
+	/* Key of the cache file for a backend; cost_size distinguishes double from float matrices. subset is the VertexSubsetFingerprint of backends that do not store all the vertices, 0 otherwise. */
+	inline uint64_t APSP_CacheKey(const std::shared_ptr <const Graph> &g, const APSP_Options &options, const std::string &backend, const size_t cost_size, const bool compute_demand, const uint64_t subset = 0) {
+		Fingerprint fp;
+		fp.Add(GraphFingerprint(g));
+		fp.Add(options.cost_fingerprint);
+		fp.Add(backend);
+		fp.Add(cost_size);
+		fp.Add(compute_demand);
+		fp.Add(subset);
+		return fp.Get();
+	}
+
+	/* File layout: Header, the size in bytes of each section (uint64), then the sections, each starting at a multiple of kAlignment */
+	class APSP_Cache {
+		static constexpr size_t kAlignment = 64;
+		static constexpr uint32_t kVersion = 2;
+
+		struct Header {
+			char magic[8];
+			uint32_t version;
+			uint32_t reserved;
+			uint64_t key;
+			uint64_t num_sections;
+			uint64_t subset;
+		};
+
+		MappedFile file_;
+		std::vector <const char *> sections_;
+
+		static void SetMagic(Header &header) {
+			std::memcpy(header.magic, "LCAPSP\0\0", 8);
+		}
+
+		static size_t AlignUp(const size_t offset) {
+			return (offset + kAlignment - 1) / kAlignment * kAlignment;
+		}
+
+		public:
+		static std::string GetFilename(const std::string &dir, const std::string &name, const uint64_t key) {
+			std::ostringstream filename;
+			filename << dir << "/" << name << "_" << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+			return filename.str();
+		}
+
+		/* Maps the file if it exists and matches the key, the vertex subset and the section sizes */
+		bool Load(const std::string &filename, const uint64_t key, const std::vector <size_t> &section_bytes, const uint64_t subset = 0) {
+			sections_.clear();
+			if(not std::filesystem::exists(filename) or file_.Open(filename) == kFail) {
+				return kFail;
+			}
+			Header expected;
+			SetMagic(expected);
+			const char *data = file_.GetData();
+			size_t offset = sizeof(Header) + section_bytes.size() * sizeof(uint64_t);
+			if(file_.GetSize() < offset) {
+				file_.Close();
+				return kFail;
+			}
+			Header header;
+			std::memcpy(&header, data, sizeof(Header));
+			if(std::memcmp(header.magic, expected.magic, 8) != 0 or header.version != kVersion or header.key != key or header.subset != subset or header.num_sections != section_bytes.size()) {
+				file_.Close();
+				return kFail;
+			}
+			for(size_t i = 0; i < section_bytes.size(); ++i) {
+				uint64_t num_bytes;
+				std::memcpy(&num_bytes, data + sizeof(Header) + i * sizeof(uint64_t), sizeof(uint64_t));
+				offset = AlignUp(offset);
+				if(num_bytes != section_bytes[i] or offset + num_bytes > file_.GetSize()) {
+					file_.Close();
+					sections_.clear();
+					return kFail;
+				}
+				sections_.push_back(data + offset);
+				offset += num_bytes;
+			}
+			return kSuccess;
+		}
+
+		const void *GetSection(const size_t i) const {
+			return sections_[i];
+		}
+
+		void Close() {
+			sections_.clear();
+			file_.Close();
+		}
+
+		/* Writes to a temporary file that is then renamed, so concurrent runs never see a partial file */
+		static bool Write(const std::string &filename, const uint64_t key, const std::vector <std::pair <const void *, size_t>> &sections, const uint64_t subset = 0) {
+			std::filesystem::path path(filename);
+			std::error_code ec;
+			std::filesystem::create_directories(path.parent_path(), ec);
+			std::string tmp_filename = filename + ".tmp" + std::to_string(getpid());
+			std::ofstream out(tmp_filename, std::ios::binary);
+			if(not out) {
+				std::cerr << "Could not write APSP cache " << filename << std::endl;
+				return kFail;
+			}
+			Header header;
+			std::memset(&header, 0, sizeof(Header));
+			SetMagic(header);
+			header.version = kVersion;
+			header.key = key;
+			header.num_sections = sections.size();
+			header.subset = subset;
+			out.write(reinterpret_cast <const char *> (&header), sizeof(Header));
+			for(const auto &section:sections) {
+				uint64_t num_bytes = section.second;
+				out.write(reinterpret_cast <const char *> (&num_bytes), sizeof(uint64_t));
+			}
+			size_t offset = sizeof(Header) + sections.size() * sizeof(uint64_t);
+			const char padding[kAlignment] = {};
+			for(const auto &section:sections) {
+				out.write(padding, AlignUp(offset) - offset);
+				offset = AlignUp(offset);
+				out.write(static_cast <const char *> (section.first), section.second);
+				offset += section.second;
+			}
+			out.close();
+			if(not out) {
+				std::filesystem::remove(tmp_filename, ec);
+				std::cerr << "Could not write APSP cache " << filename << std::endl;
+				return kFail;
+			}
+			std::filesystem::rename(tmp_filename, filename, ec);
+			if(ec) {
+				std::filesystem::remove(tmp_filename, ec);
+				return kFail;
+			}
+			return kSuccess;
+		}
+	};
+
+} // namespace lclibrary
+
+#endif /* LCLIBRARY_ALGORITHMS_APSP_CACHE_H_ */
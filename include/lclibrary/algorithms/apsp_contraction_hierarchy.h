@@ -0,0 +1,527 @@
+/**
+ * This file is part of the LineCoverage-library.
+ * The file contains a contraction hierarchy that answers shortest path queries without an n x n matrix
+ *
+ * TODO: Cache the hierarchy on disk
+ *
+ * @author Saurav Agarwal
+ * @contact sagarw10@uncc.edu
+ * @contact agr.saurav1@gmail.com
+ * Repository: https://github.com/UNCCharlotte-Robotics/LineCoverage-library
+ *
+ * Copyright (C) 2020--2022 University of North Carolina at Charlotte.
+ * The LineCoverage-library is owned by the University of North Carolina at Charlotte and is protected by United States copyright laws and applicable international treaties and/or conventions.
+ *
+ * The LineCoverage-library is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * DISCLAIMER OF WARRANTIES: THE SOFTWARE IS PROVIDED "AS-IS" WITHOUT WARRANTY OF ANY KIND INCLUDING ANY WARRANTIES OF PERFORMANCE OR MERCHANTABILITY OR FITNESS FOR A PARTICULAR USE OR PURPOSE OR OF NON-INFRINGEMENT. YOU BEAR ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE SOFTWARE OR HARDWARE.
+ *
+ * SUPPORT AND MAINTENANCE: No support, installation, or training is provided.
+ *
+ * You should have received a copy of the GNU General Public License along with LineCoverage-library. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LCLIBRARY_ALGORITHMS_APSP_CONTRACTION_HIERARCHY_H_
+#define LCLIBRARY_ALGORITHMS_APSP_CONTRACTION_HIERARCHY_H_
+
+#include <lclibrary/core/constants.h>
+#include <lclibrary/core/graph.h>
+#include <lclibrary/algorithms/apsp_base.h>
+#include <lclibrary/algorithms/dijkstra.h>
+#include <lclibrary/utils/thread_pool.h>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+namespace lclibrary {
+
+	/* For graphs whose n x n matrices do not fit in memory but that need many point-to-point queries, e.g. metro-scale road networks. Vertices are contracted in order of importance, and shortcuts are added between their neighbors to keep the distances of the remaining graph. A query is then a bidirectional Dijkstra that only moves to more important vertices and settles a few hundred vertices on road networks. Preprocessing contracts an independent set of vertices in each round, distributed over a thread pool. */
+	class APSP_ContractionHierarchy : public APSP {
+		/* Witness searches stop after settling this many vertices; a witness that is not found only adds an unneeded shortcut. Priorities are estimated with shorter searches. */
+		static constexpr size_t kMaxSettled = 500;
+		static constexpr size_t kMaxSettledPriority = 50;
+
+		enum VertexState : char {kRemaining, kInRound, kContracted};
+
+		struct CH_Edge {
+			size_t tail_;
+			size_t head_;
+			double cost_;
+			double demand_;
+			size_t first_; /* Arc of an original edge, or the first of the two edges a shortcut replaces */
+			size_t second_; /* kNIL for an original edge */
+		};
+
+		/* other_ is the head in the upward graph and the tail in the downward graph */
+		struct SearchEdge {
+			size_t other_;
+			double cost_;
+			size_t edge_;
+		};
+
+		/* Labels of one search; only the touched entries are reset so that a query costs O(search space) and not O(n) */
+		struct SearchSpace {
+			typedef std::pair <double, size_t> HeapEntry;
+			std::vector <double> distance_;
+			std::vector <size_t> pred_edge_;
+			std::vector <size_t> touched_;
+			std::vector <HeapEntry> heap_; /* Min-heap; a plain vector keeps its capacity across searches */
+
+			void Resize(const size_t n) {
+				if(distance_.size() < n) {
+					distance_.resize(n, kDoubleMax);
+					pred_edge_.resize(n, kNIL);
+				}
+			}
+
+			void Set(const size_t v, const double d, const size_t e) {
+				if(distance_[v] == kDoubleMax) {
+					touched_.push_back(v);
+				}
+				distance_[v] = d;
+				pred_edge_[v] = e;
+				heap_.push_back(HeapEntry(d, v));
+				std::push_heap(heap_.begin(), heap_.end(), std::greater <HeapEntry>());
+			}
+
+			HeapEntry Pop() {
+				std::pop_heap(heap_.begin(), heap_.end(), std::greater <HeapEntry>());
+				HeapEntry top = heap_.back();
+				heap_.pop_back();
+				return top;
+			}
+
+			void Clear() {
+				for(const auto &v:touched_) {
+					distance_[v] = kDoubleMax;
+					pred_edge_[v] = kNIL;
+				}
+				touched_.clear();
+				heap_.clear();
+			}
+		};
+
+		std::shared_ptr <const Graph> g_;
+		size_t n_;
+		DeadheadArcs arcs_;
+		bool compute_demand_ = false;
+		APSP_Options options_;
+		std::vector <CH_Edge> edges_;
+		std::vector <size_t> rank_;
+		/* The upward graph has the edges from v to more important vertices, the downward graph the edges into v from more important vertices */
+		std::vector <size_t> up_offsets_;
+		std::vector <SearchEdge> up_edges_;
+		std::vector <size_t> down_offsets_;
+		std::vector <SearchEdge> down_edges_;
+		size_t num_shortcuts_ = 0;
+
+		/* Remaining graph during preprocessing */
+		std::vector <std::vector <size_t>> out_;
+		std::vector <std::vector <size_t>> in_;
+		std::vector <VertexState> state_;
+		std::vector <int64_t> priority_;
+		std::vector <size_t> deleted_neighbors_;
+
+		/* Each thread keeps its search spaces: two for queries and one for witness searches */
+		SearchSpace &GetSearchSpace(const size_t k) const {
+			static thread_local SearchSpace spaces[3];
+			spaces[k].Resize(n_);
+			return spaces[k];
+		}
+
+		/* Keeps the cheapest arc between each pair of vertices */
+		void InitializeEdges() {
+			out_.assign(n_, {});
+			in_.assign(n_, {});
+			std::vector <size_t> arc_to_head(n_, kNIL);
+			for(size_t u = 0; u < n_; ++u) {
+				const size_t first = edges_.size();
+				for(size_t a = arcs_.GetArcsBegin(u); a < arcs_.GetArcsEnd(u); ++a) {
+					const auto &arc = arcs_.GetArc(a);
+					if(arc.head_ == u) {
+						continue;
+					}
+					size_t &e = arc_to_head[arc.head_];
+					if(e == kNIL) {
+						e = edges_.size();
+						edges_.push_back(CH_Edge{u, arc.head_, arc.cost_, arc.demand_, a, kNIL});
+					} else if(arc.cost_ < edges_[e].cost_) {
+						edges_[e] = CH_Edge{u, arc.head_, arc.cost_, arc.demand_, a, kNIL};
+					}
+				}
+				for(size_t e = first; e < edges_.size(); ++e) {
+					arc_to_head[edges_[e].head_] = kNIL;
+					out_[u].push_back(e);
+					in_[edges_[e].head_].push_back(e);
+				}
+			}
+		}
+
+		/* Shortcuts needed to contract v: the path u v w for each remaining edge (u, v) and (v, w), unless a path from u to w that avoids v and the vertices of the current round is no longer */
+		void FindShortcuts(const size_t v, const size_t max_settled, std::vector <CH_Edge> &shortcuts) const {
+			SearchSpace &space = GetSearchSpace(2);
+			for(const auto &e_in:in_[v]) {
+				const CH_Edge &edge_in = edges_[e_in];
+				const size_t u = edge_in.tail_;
+				double max_cost = -1;
+				for(const auto &e_out:out_[v]) {
+					if(edges_[e_out].head_ != u) {
+						max_cost = std::max(max_cost, edge_in.cost_ + edges_[e_out].cost_);
+					}
+				}
+				if(max_cost < 0) {
+					continue;
+				}
+				space.Set(u, 0, kNIL);
+				size_t num_settled = 0;
+				while(not space.heap_.empty()) {
+					auto [d, x] = space.Pop();
+					if(d > space.distance_[x]) {
+						continue;
+					}
+					if(d > max_cost or ++num_settled > max_settled) {
+						break;
+					}
+					for(const auto &e:out_[x]) {
+						const size_t y = edges_[e].head_;
+						const double new_distance = d + edges_[e].cost_;
+						if(y != v and state_[y] == kRemaining and new_distance < space.distance_[y]) {
+							space.Set(y, new_distance, e);
+						}
+					}
+				}
+				for(const auto &e_out:out_[v]) {
+					const CH_Edge &edge_out = edges_[e_out];
+					const double cost = edge_in.cost_ + edge_out.cost_;
+					if(edge_out.head_ != u and space.distance_[edge_out.head_] > cost) {
+						shortcuts.push_back(CH_Edge{u, edge_out.head_, cost, edge_in.demand_ + edge_out.demand_, e_in, e_out});
+					}
+				}
+				space.Clear();
+			}
+		}
+
+		/* Shortcuts added, weighted twice, minus edges removed, plus the number of contracted neighbors, which spreads the contraction uniformly over the graph */
+		int64_t ComputePriority(const size_t v) const {
+			std::vector <CH_Edge> shortcuts;
+			FindShortcuts(v, kMaxSettledPriority, shortcuts);
+			return 2 * int64_t(shortcuts.size()) - int64_t(in_[v].size() + out_[v].size()) + int64_t(deleted_neighbors_[v]);
+		}
+
+		/* Smaller priority is contracted first. Ties are broken by a hash of the index; with the index itself, a region of equal priorities would give one vertex per round. */
+		bool IsBefore(const size_t v, const size_t u) const {
+			if(priority_[v] != priority_[u]) {
+				return priority_[v] < priority_[u];
+			}
+			return uint64_t(v) * 0x9E3779B97F4A7C15ULL < uint64_t(u) * 0x9E3779B97F4A7C15ULL;
+		}
+
+		/* Contracted in this round if it comes before all its remaining neighbors; such vertices are never adjacent */
+		bool IsLocalMinimum(const size_t v) const {
+			for(const auto &e:out_[v]) {
+				if(not IsBefore(v, edges_[e].head_)) {
+					return false;
+				}
+			}
+			for(const auto &e:in_[v]) {
+				if(not IsBefore(v, edges_[e].tail_)) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		static void RemoveEdge(std::vector <size_t> &edge_list, const size_t e) {
+			auto it = std::find(edge_list.begin(), edge_list.end(), e);
+			if(it != edge_list.end()) {
+				*it = edge_list.back();
+				edge_list.pop_back();
+			}
+		}
+
+		/* Replaces an edge between the same vertices if the shortcut is cheaper */
+		void AddShortcut(const CH_Edge &shortcut) {
+			for(auto &e:out_[shortcut.tail_]) {
+				if(edges_[e].head_ != shortcut.head_) {
+					continue;
+				}
+				if(edges_[e].cost_ <= shortcut.cost_) {
+					return;
+				}
+				RemoveEdge(in_[shortcut.head_], e);
+				e = edges_.size();
+				edges_.push_back(shortcut);
+				in_[shortcut.head_].push_back(e);
+				++num_shortcuts_;
+				return;
+			}
+			out_[shortcut.tail_].push_back(edges_.size());
+			in_[shortcut.head_].push_back(edges_.size());
+			edges_.push_back(shortcut);
+			++num_shortcuts_;
+		}
+
+		/* Moves the remaining edges of v to the upward and downward graphs */
+		void Contract(const size_t v, std::vector <std::vector <SearchEdge>> &up, std::vector <std::vector <SearchEdge>> &down, std::vector <size_t> &neighbors) {
+			for(const auto &e:out_[v]) {
+				const size_t w = edges_[e].head_;
+				up[v].push_back(SearchEdge{w, edges_[e].cost_, e});
+				RemoveEdge(in_[w], e);
+				neighbors.push_back(w);
+			}
+			for(const auto &e:in_[v]) {
+				const size_t u = edges_[e].tail_;
+				down[v].push_back(SearchEdge{u, edges_[e].cost_, e});
+				RemoveEdge(out_[u], e);
+				neighbors.push_back(u);
+			}
+			std::vector <size_t>().swap(out_[v]);
+			std::vector <size_t>().swap(in_[v]);
+			state_[v] = kContracted;
+		}
+
+		static void BuildSearchGraph(const std::vector <std::vector <SearchEdge>> &lists, std::vector <size_t> &offsets, std::vector <SearchEdge> &edges) {
+			offsets.assign(lists.size() + 1, 0);
+			for(size_t v = 0; v < lists.size(); ++v) {
+				offsets[v + 1] = offsets[v] + lists[v].size();
+			}
+			edges.clear();
+			edges.reserve(offsets.back());
+			for(const auto &list:lists) {
+				edges.insert(edges.end(), list.begin(), list.end());
+			}
+		}
+
+		/* Bidirectional search on the upward graph from s and the downward graph from t. Returns the distance and the vertex where the two paths meet. Stall-on-demand skips vertices that are reached more cheaply through a more important vertex. */
+		double Query(const size_t s, const size_t t, SearchSpace &forward, SearchSpace &backward, size_t &meeting) const {
+			double best = kDoubleMax;
+			meeting = kNIL;
+			forward.Set(s, 0, kNIL);
+			backward.Set(t, 0, kNIL);
+			while(not forward.heap_.empty() or not backward.heap_.empty()) {
+				const bool is_forward = backward.heap_.empty() or (not forward.heap_.empty() and forward.heap_.front().first <= backward.heap_.front().first);
+				SearchSpace &space = is_forward ? forward : backward;
+				const SearchSpace &other = is_forward ? backward : forward;
+				auto [d, u] = space.Pop();
+				if(d >= best) {
+					break;
+				}
+				if(d > space.distance_[u]) {
+					continue;
+				}
+				if(other.distance_[u] != kDoubleMax and d + other.distance_[u] < best) {
+					best = d + other.distance_[u];
+					meeting = u;
+				}
+				const std::vector <size_t> &stall_offsets = is_forward ? down_offsets_ : up_offsets_;
+				const std::vector <SearchEdge> &stall_edges = is_forward ? down_edges_ : up_edges_;
+				bool is_stalled = false;
+				for(size_t k = stall_offsets[u]; k < stall_offsets[u + 1]; ++k) {
+					const double distance_x = space.distance_[stall_edges[k].other_];
+					if(distance_x != kDoubleMax and distance_x + stall_edges[k].cost_ < d) {
+						is_stalled = true;
+						break;
+					}
+				}
+				if(is_stalled) {
+					continue;
+				}
+				const std::vector <size_t> &offsets = is_forward ? up_offsets_ : down_offsets_;
+				const std::vector <SearchEdge> &search_edges = is_forward ? up_edges_ : down_edges_;
+				for(size_t k = offsets[u]; k < offsets[u + 1]; ++k) {
+					const double new_distance = d + search_edges[k].cost_;
+					if(new_distance < space.distance_[search_edges[k].other_]) {
+						space.Set(search_edges[k].other_, new_distance, search_edges[k].edge_);
+					}
+				}
+			}
+			return best;
+		}
+
+		/* Edges of the hierarchy on the path found by Query(), in order */
+		void GetQueryPath(const size_t meeting, const SearchSpace &forward, const SearchSpace &backward, std::vector <size_t> &path) const {
+			for(size_t v = meeting; forward.pred_edge_[v] != kNIL; v = edges_[forward.pred_edge_[v]].tail_) {
+				path.push_back(forward.pred_edge_[v]);
+			}
+			std::reverse(path.begin(), path.end());
+			for(size_t v = meeting; backward.pred_edge_[v] != kNIL; v = edges_[backward.pred_edge_[v]].head_) {
+				path.push_back(backward.pred_edge_[v]);
+			}
+		}
+
+		/* Arcs that the edge stands for, in order */
+		void UnpackEdge(const size_t e, std::vector <size_t> &arc_list) const {
+			std::vector <size_t> stack{e};
+			while(not stack.empty()) {
+				const CH_Edge &edge = edges_[stack.back()];
+				stack.pop_back();
+				if(edge.second_ == kNIL) {
+					arc_list.push_back(edge.first_);
+				} else {
+					stack.push_back(edge.second_);
+					stack.push_back(edge.first_);
+				}
+			}
+		}
+
+		public:
+		APSP_ContractionHierarchy(const std::shared_ptr <const Graph> &g) : APSP_ContractionHierarchy(g, false) {}
+
+		APSP_ContractionHierarchy(const std::shared_ptr <const Graph> &g, bool compute_demand) : APSP_ContractionHierarchy(g, compute_demand, APSP_Options()) {}
+
+		APSP_ContractionHierarchy(const std::shared_ptr <const Graph> &g, bool compute_demand, const APSP_Options &options) : g_{g}, n_{g->GetN()}, arcs_(g), compute_demand_{compute_demand}, options_{options} { }
+
+		bool APSP_Deadheading() {
+			edges_.clear();
+			num_shortcuts_ = 0;
+			InitializeEdges();
+			state_.assign(n_, kRemaining);
+			deleted_neighbors_.assign(n_, 0);
+			priority_.assign(n_, 0);
+			rank_.assign(n_, kNIL);
+			ThreadPool pool(options_.num_threads);
+			pool.ParallelFor(0, n_, [&](size_t v) {
+					priority_[v] = ComputePriority(v);
+					});
+
+			std::vector <std::vector <SearchEdge>> up(n_), down(n_);
+			std::vector <size_t> remaining(n_);
+			for(size_t v = 0; v < n_; ++v) {
+				remaining[v] = v;
+			}
+			std::vector <char> is_selected(n_, false);
+			std::vector <size_t> selected, neighbors;
+			std::vector <std::vector <CH_Edge>> shortcuts;
+			size_t next_rank = 0;
+			while(not remaining.empty()) {
+				pool.ParallelFor(0, remaining.size(), [&](size_t k) {
+						is_selected[k] = IsLocalMinimum(remaining[k]);
+						});
+				selected.clear();
+				size_t num_remaining = 0;
+				for(size_t k = 0; k < remaining.size(); ++k) {
+					if(is_selected[k]) {
+						selected.push_back(remaining[k]);
+						state_[remaining[k]] = kInRound;
+					} else {
+						remaining[num_remaining++] = remaining[k];
+					}
+				}
+				remaining.resize(num_remaining);
+
+				shortcuts.assign(selected.size(), {});
+				pool.ParallelFor(0, selected.size(), [&](size_t k) {
+						FindShortcuts(selected[k], kMaxSettled, shortcuts[k]);
+						});
+				neighbors.clear();
+				for(size_t k = 0; k < selected.size(); ++k) {
+					rank_[selected[k]] = next_rank++;
+					Contract(selected[k], up, down, neighbors);
+					for(const auto &shortcut:shortcuts[k]) {
+						AddShortcut(shortcut);
+					}
+				}
+
+				for(const auto &u:neighbors) {
+					++deleted_neighbors_[u];
+				}
+				std::sort(neighbors.begin(), neighbors.end());
+				neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+				pool.ParallelFor(0, neighbors.size(), [&](size_t k) {
+						priority_[neighbors[k]] = ComputePriority(neighbors[k]);
+						});
+			}
+
+			BuildSearchGraph(up, up_offsets_, up_edges_);
+			BuildSearchGraph(down, down_offsets_, down_edges_);
+			std::vector <std::vector <size_t>>().swap(out_);
+			std::vector <std::vector <size_t>>().swap(in_);
+			std::vector <VertexState>().swap(state_);
+			std::vector <int64_t>().swap(priority_);
+			std::vector <size_t>().swap(deleted_neighbors_);
+			return kSuccess;
+		}
+
+		void GetPath(std::vector < Edge > &edge_list, const size_t i, const size_t j) const {
+			SearchSpace &forward = GetSearchSpace(0);
+			SearchSpace &backward = GetSearchSpace(1);
+			size_t meeting;
+			Query(i, j, forward, backward, meeting);
+			std::vector <size_t> path, arc_list;
+			if(meeting != kNIL) {
+				GetQueryPath(meeting, forward, backward, path);
+			}
+			forward.Clear();
+			backward.Clear();
+			for(const auto &e:path) {
+				UnpackEdge(e, arc_list);
+			}
+			for(const auto &a:arc_list) {
+				const auto &arc = arcs_.GetArc(a);
+				AddDeadheadEdge(edge_list, arc.edge_, arc.rev_);
+			}
+		}
+
+		double GetCost(const size_t i, const size_t j) const {
+			SearchSpace &forward = GetSearchSpace(0);
+			SearchSpace &backward = GetSearchSpace(1);
+			size_t meeting;
+			double cost = Query(i, j, forward, backward, meeting);
+			forward.Clear();
+			backward.Clear();
+			return cost;
+		}
+
+		double GetDemand(const size_t i, const size_t j) const {
+			if(not compute_demand_) {
+				return kDoubleNaN;
+			}
+			SearchSpace &forward = GetSearchSpace(0);
+			SearchSpace &backward = GetSearchSpace(1);
+			size_t meeting;
+			Query(i, j, forward, backward, meeting);
+			std::vector <size_t> path;
+			if(meeting != kNIL) {
+				GetQueryPath(meeting, forward, backward, path);
+			}
+			forward.Clear();
+			backward.Clear();
+			if(meeting == kNIL) {
+				return kDoubleMax;
+			}
+			double demand = 0;
+			for(const auto &e:path) {
+				demand += edges_[e].demand_;
+			}
+			return demand;
+		}
+
+		size_t GetNumShortcuts() const {
+			return num_shortcuts_;
+		}
+
+		/* Position of v in the contraction order */
+		size_t GetRank(const size_t v) const {
+			return rank_[v];
+		}
+
+		/* The per-thread search spaces are not counted */
+		size_t MemoryFootprint() const {
+			size_t bytes = arcs_.MemoryFootprint() + VectorBytes(edges_) + VectorBytes(rank_);
+			bytes += VectorBytes(up_offsets_) + VectorBytes(up_edges_) + VectorBytes(down_offsets_) + VectorBytes(down_edges_);
+			bytes += VectorBytes(out_) + VectorBytes(in_) + VectorBytes(state_) + VectorBytes(priority_) + VectorBytes(deleted_neighbors_);
+			for(size_t v = 0; v < out_.size(); ++v) {
+				bytes += VectorBytes(out_[v]);
+			}
+			for(size_t v = 0; v < in_.size(); ++v) {
+				bytes += VectorBytes(in_[v]);
+			}
+			return bytes;
+		}
+
+	};
+
+} // namespace lclibrary
+
+#endif /* LCLIBRARY_ALGORITHMS_APSP_CONTRACTION_HIERARCHY_H_ */
@@ -0,0 +1,204 @@
+/**
+ * This file is part of the LineCoverage-library.
+ * The file contains all pair shortest paths using Dijkstra's algorithm from every vertex
+ *
+ * TODO:
+ *
+ * @author Saurav Agarwal
+ * @contact sagarw10@uncc.edu
+ * @contact agr.saurav1@gmail.com
+ * Repository: https://github.com/UNCCharlotte-Robotics/LineCoverage-library
+ *
+ * Copyright (C) 2020--2022 University of North Carolina at Charlotte.
+ * The LineCoverage-library is owned by the University of North Carolina at Charlotte and is protected by United States copyright laws and applicable international treaties and/or conventions.
+ *
+ * The LineCoverage-library is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * DISCLAIMER OF WARRANTIES: THE SOFTWARE IS PROVIDED "AS-IS" WITHOUT WARRANTY OF ANY KIND INCLUDING ANY WARRANTIES OF PERFORMANCE OR MERCHANTABILITY OR FITNESS FOR A PARTICULAR USE OR PURPOSE OR OF NON-INFRINGEMENT. YOU BEAR ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE SOFTWARE OR HARDWARE.
+ *
+ * SUPPORT AND MAINTENANCE: No support, installation, or training is provided.
+ *
+ * You should have received a copy of the GNU General Public License along with LineCoverage-library. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LCLIBRARY_ALGORITHMS_APSP_DIJKSTRA_H_
+#define LCLIBRARY_ALGORITHMS_APSP_DIJKSTRA_H_
+
+#include <lclibrary/core/constants.h>
+#include <lclibrary/core/graph.h>
+#include <lclibrary/algorithms/apsp_base.h>
+#include <lclibrary/algorithms/apsp_cache.h>
+#include <lclibrary/algorithms/dijkstra.h>
+#include <lclibrary/utils/thread_pool.h>
+#include <memory>
+
+namespace lclibrary {
+
+	/* Suited to sparse graphs: O(n m log n) instead of O(n^3). Sources are distributed over a thread pool. */
+	class APSP_Dijkstra : public APSP {
+		std::shared_ptr <const Graph> g_;
+		size_t n_;
+		DeadheadArcs arcs_;
+		/* Row i holds the shortest path tree from vertex i; n x n row-major */
+		std::vector <double> distance_;
+		std::vector <double> demand_;
+		std::vector <size_t> pred_arc_;
+		/* Point either to the matrices above or to the sections of a mapped cache file */
+		APSP_Cache cache_;
+		const double *distance_data_ = nullptr;
+		const double *demand_data_ = nullptr;
+		const size_t *pred_arc_data_ = nullptr;
+		bool demand_requested_ = false;
+		/* Whether the demand matrix is stored. It is not if demands equal costs, or with lazy_demand, in which case demands are summed along the paths. */
+		bool compute_demand_ = false;
+		bool demand_is_cost_ = false;
+		bool lazy_demand_ = false;
+		mutable APSP_DemandMemo demand_memo_;
+		APSP_Options options_;
+
+		inline size_t Index(const size_t i, const size_t j) const {
+			return i * n_ + j;
+		}
+
+		void SetDemandMode() {
+			demand_is_cost_ = demand_requested_ and arcs_.DemandsEqualCosts();
+			lazy_demand_ = demand_requested_ and not demand_is_cost_ and options_.lazy_demand;
+			compute_demand_ = demand_requested_ and not demand_is_cost_ and not lazy_demand_;
+			demand_memo_.Clear();
+		}
+
+		/* Sums the demands of the arcs on the path from i to j in the order Dijkstra() adds them */
+		double GetPathDemand(const size_t i, const size_t j) const {
+			const uint64_t key = Index(i, j);
+			double demand = 0;
+			if(demand_memo_.Find(key, demand)) {
+				return demand;
+			}
+			if(distance_data_[Index(i, j)] == kDoubleMax) {
+				demand = kDoubleMax;
+			}
+			else {
+				std::vector <size_t> path;
+				GetTreePath(arcs_, &pred_arc_data_[Index(i, 0)], j, path);
+				for(const auto &a:path) {
+					demand += arcs_.GetArc(a).demand_;
+				}
+			}
+			demand_memo_.Insert(key, demand);
+			return demand;
+		}
+
+		public:
+		APSP_Dijkstra(const std::shared_ptr <const Graph> &g) : APSP_Dijkstra(g, false) {}
+
+		APSP_Dijkstra(const std::shared_ptr <const Graph> &g, bool compute_demand) : APSP_Dijkstra(g, compute_demand, APSP_Options()) {}
+
+		APSP_Dijkstra(const std::shared_ptr <const Graph> &g, bool compute_demand, const APSP_Options &options) : g_{g}, n_{g->GetN()}, arcs_(g), demand_requested_{compute_demand}, options_{options} { }
+
+		bool APSP_Deadheading() {
+			SetDemandMode();
+			const size_t matrix_size = n_ * n_;
+			std::vector <size_t> section_bytes{matrix_size * sizeof(double), compute_demand_ ? matrix_size * sizeof(double) : 0, matrix_size * sizeof(size_t)};
+			std::string cache_filename;
+			uint64_t cache_key = 0;
+			if(not options_.cache_dir.empty()) {
+				cache_key = APSP_CacheKey(g_, options_, "dijkstra", sizeof(double), compute_demand_);
+				cache_filename = APSP_Cache::GetFilename(options_.cache_dir, "dijkstra", cache_key);
+				if(cache_.Load(cache_filename, cache_key, section_bytes) == kSuccess) {
+					distance_data_ = static_cast <const double *> (cache_.GetSection(0));
+					demand_data_ = static_cast <const double *> (cache_.GetSection(1));
+					pred_arc_data_ = static_cast <const size_t *> (cache_.GetSection(2));
+					return kSuccess;
+				}
+			}
+
+			distance_.resize(n_ * n_);
+			pred_arc_.resize(n_ * n_);
+			if(compute_demand_) {
+				demand_.resize(n_ * n_);
+			} else {
+				std::vector <double>().swap(demand_);
+			}
+			ThreadPool pool(options_.num_threads);
+			pool.ParallelFor(0, n_, [&](size_t i) {
+					double *demand_i = compute_demand_ ? &demand_[Index(i, 0)] : nullptr;
+					Dijkstra(arcs_, i, &distance_[Index(i, 0)], demand_i, &pred_arc_[Index(i, 0)]);
+					});
+			distance_data_ = distance_.data();
+			demand_data_ = demand_.data();
+			pred_arc_data_ = pred_arc_.data();
+			if(not cache_filename.empty()) {
+				APSP_Cache::Write(cache_filename, cache_key, {{distance_data_, section_bytes[0]}, {demand_data_, section_bytes[1]}, {pred_arc_data_, section_bytes[2]}});
+			}
+			return kSuccess;
+		}
+
+		bool UpdateDeadheadCosts() {
+			if(distance_data_ == nullptr) {
+				std::cerr << "APSP_Deadheading must be called before UpdateDeadheadCosts\n";
+				return kFail;
+			}
+			std::vector <size_t> invalidating_arcs, decreased_arcs;
+			arcs_.Update(invalidating_arcs, decreased_arcs);
+			if(invalidating_arcs.empty() and decreased_arcs.empty()) {
+				return kSuccess;
+			}
+			demand_memo_.Clear();
+			if(demand_requested_ and demand_is_cost_ != arcs_.DemandsEqualCosts()) {
+				return APSP_Deadheading();
+			}
+			/* Results loaded from the cache are read-only */
+			if(distance_data_ != distance_.data()) {
+				distance_.assign(distance_data_, distance_data_ + n_ * n_);
+				pred_arc_.assign(pred_arc_data_, pred_arc_data_ + n_ * n_);
+				if(compute_demand_) {
+					demand_.assign(demand_data_, demand_data_ + n_ * n_);
+				}
+				distance_data_ = distance_.data();
+				demand_data_ = demand_.data();
+				pred_arc_data_ = pred_arc_.data();
+				cache_.Close();
+			}
+			ThreadPool pool(options_.num_threads);
+			pool.ParallelFor(0, n_, [&](size_t i) {
+					double *demand_i = compute_demand_ ? &demand_[Index(i, 0)] : nullptr;
+					UpdateShortestPathTree(arcs_, invalidating_arcs, decreased_arcs, &distance_[Index(i, 0)], demand_i, &pred_arc_[Index(i, 0)]);
+					});
+			return kSuccess;
+		}
+
+		void GetPath(std::vector < Edge > &edge_list, const size_t i, const size_t j) const {
+			std::vector <size_t> path;
+			GetTreePath(arcs_, &pred_arc_data_[Index(i, 0)], j, path);
+			for(const auto &a:path) {
+				const auto &arc = arcs_.GetArc(a);
+				AddDeadheadEdge(edge_list, arc.edge_, arc.rev_);
+			}
+		}
+
+		double GetCost(const size_t i, const size_t j) const {
+			return distance_data_[Index(i, j)];
+		}
+
+		double GetDemand(const size_t i, const size_t j) const {
+			if(demand_is_cost_) {
+				return GetCost(i, j);
+			}
+			if(lazy_demand_) {
+				return GetPathDemand(i, j);
+			}
+			if(not compute_demand_) {
+				return kDoubleNaN;
+			}
+			return demand_data_[Index(i, j)];
+		}
+
+		size_t MemoryFootprint() const {
+			return arcs_.MemoryFootprint() + VectorBytes(distance_) + VectorBytes(demand_) + VectorBytes(pred_arc_) + demand_memo_.MemoryFootprint();
+		}
+
+	};
+
+} // namespace lclibrary
+
+#endif /* LCLIBRARY_ALGORITHMS_APSP_DIJKSTRA_H_ */
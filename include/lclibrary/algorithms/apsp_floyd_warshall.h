@@ -29,149 +29,482 @@
 #include <lclibrary/core/vertex.h>
 #include <lclibrary/core/graph.h>
 #include <lclibrary/algorithms/apsp_base.h>
+#include <lclibrary/algorithms/apsp_cache.h>
+#include <lclibrary/algorithms/dijkstra.h>
+#include <lclibrary/utils/thread_pool.h>
+#include <lclibrary/utils/aligned_allocator.h>
+#include <lclibrary/utils/min_plus.h>
 #include <memory>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+#include <iostream>
 
 namespace lclibrary {
 
-	class APSP_FloydWarshall : public APSP {
+	/* CostType is double, or float to halve the distance and demand matrices at the cost of precision */
+	template <typename CostType>
+	class BasicAPSP_FloydWarshall : public APSP {
+		/* Tile size of the blocked Floyd-Warshall; three tiles of doubles fit in L2 */
+		static constexpr size_t kBlockSize = 64;
+		static constexpr CostType kInfinity = std::numeric_limits<CostType>::max();
+		static constexpr uint32_t kNIL32 = std::numeric_limits<uint32_t>::max();
+
 		std::shared_ptr <const Graph> g_;
 		size_t n_;
 		size_t m_;
 		size_t m_nr_;
-		std::vector <std::vector <double> > distance_;
-		std::vector <std::vector <double> > demand_;
-		std::vector <std::vector <size_t> > helper_;
-		std::vector <std::vector < EdgeTuple> > helper_edge_;
+		/* n x n matrices stored row-major in contiguous buffers. successor_ is the vertex after i on the path from i to j. edge_id_ is the cheapest edge from i to j, see EdgeID(). */
+		AlignedVector <CostType> distance_;
+		AlignedVector <CostType> demand_;
+		AlignedVector <uint32_t> successor_;
+		std::vector <uint32_t> edge_id_;
+		bool demand_requested_ = false;
+		/* Whether the demand matrix is stored. It is not if demands equal costs, or with lazy_demand, in which case demands are summed along the paths. */
 		bool compute_demand_ = false;
+		bool demand_is_cost_ = false;
+		bool lazy_demand_ = false;
+		bool is_supported_ = false;
+		mutable APSP_DemandMemo demand_memo_;
+		APSP_Options options_;
+		/* Row k and column k of the matrix as they are at iteration k of the textbook algorithm, for all k in the current phase. Relaxing every tile from these snapshots gives exactly the same updates, in the same order per entry, as the unblocked triple loop. */
+		AlignedVector <CostType> row_snapshot_;
+		AlignedVector <CostType> column_snapshot_;
+		AlignedVector <CostType> row_demand_snapshot_;
+		AlignedVector <CostType> column_demand_snapshot_;
+		AlignedVector <uint32_t> column_successor_snapshot_;
+		/* Point either to the matrices above or to the sections of a mapped cache file */
+		APSP_Cache cache_;
+		const CostType *distance_data_ = nullptr;
+		const CostType *demand_data_ = nullptr;
+		const uint32_t *successor_data_ = nullptr;
+		const uint32_t *edge_id_data_ = nullptr;
+		/* Deadheading costs the matrices were computed with, for UpdateDeadheadCosts() */
+		std::unique_ptr <DeadheadArcs> arcs_;
+
+		inline size_t Index(const size_t i, const size_t j) const {
+			return i * n_ + j;
+		}
+
+		/* Edge index, required flag and direction packed in 32 bits; the edge index must be below 2^30, see IsSupported() */
+		static inline uint32_t EdgeID(const size_t edge_index, const bool req, const bool is_rev) {
+			return uint32_t(edge_index << 2) | (req ? 2 : 0) | (is_rev ? 1 : 0);
+		}
 
 		void Initialize() {
-			distance_.resize(n_, std::vector <double> (n_, kDoubleMax));
-			helper_.resize(n_, std::vector <size_t> (n_, kNIL));
-			helper_edge_.resize(n_, std::vector <EdgeTuple>(n_, MakeEdgeTuple(nullptr, kIsRequired)));
+			distance_.assign(n_ * n_, kInfinity);
+			successor_.assign(n_ * n_, kNIL32);
+			edge_id_.assign(n_ * n_, kNIL32);
 			if(compute_demand_) {
-				demand_.resize(n_, std::vector <double> (n_, kDoubleMax));
+				demand_.assign(n_ * n_, kInfinity);
+			} else {
+				AlignedVector <CostType>().swap(demand_);
 			}
 		}
 
-		void GetPath(std::vector < EdgeTuple > &path, size_t i, size_t j) const {
-			if(helper_[i][j] == kNIL)
-				path.push_back(helper_edge_[i][j]);
-			else {
-				GetPath(path, i, helper_[i][j]);
-				GetPath(path, helper_[i][j], j);
-			}
+		void SetDemandMode() {
+			demand_is_cost_ = demand_requested_ and arcs_->DemandsEqualCosts();
+			lazy_demand_ = demand_requested_ and not demand_is_cost_ and options_.lazy_demand;
+			compute_demand_ = demand_requested_ and not demand_is_cost_ and not lazy_demand_;
+			demand_memo_.Clear();
 		}
 
-		public:
-		APSP_FloydWarshall(std::shared_ptr <const Graph> &g) : g_{g} {
-			n_ = g_->GetN();
-			m_ = g_->GetM();
-			m_nr_ = g_->GetMnr();
-			Initialize();
+		/* Sums the demands of the edges on the path from i to j */
+		double GetPathDemand(const size_t i, const size_t j) const {
+			const uint64_t key = Index(i, j);
+			double demand = 0;
+			if(demand_memo_.Find(key, demand)) {
+				return demand;
+			}
+			for(size_t u = i; u != j; ) {
+				uint32_t v = successor_data_[Index(u, j)];
+				if(v == kNIL32) {
+					demand = kDoubleMax;
+					break;
+				}
+				uint32_t id = edge_id_data_[Index(u, v)];
+				const Edge *e = g_->GetEdge(id >> 2, id & 2);
+				demand += (id & 1) ? e->GetReverseDeadheadDemand() : e->GetDeadheadDemand();
+				u = v;
+			}
+			demand_memo_.Insert(key, demand);
+			return demand;
 		}
 
-		APSP_FloydWarshall(std::shared_ptr <const Graph> &g, bool compute_demand) : g_{g}, compute_demand_{compute_demand} {
-			n_ = g_->GetN();
-			m_ = g_->GetM();
-			m_nr_ = g_->GetMnr();
-			Initialize();
+		void InitializeEdges(const size_t num_edges, const bool req) {
+			for(size_t i = 0; i < num_edges; ++i) {
+				size_t t, h;
+				g_->GetVerticesIndexOfEdge(i, t, h, req);
+				CostType cost = g_->GetDeadheadCost(i, req);
+				if (cost < distance_[Index(t, h)]) {
+					distance_[Index(t, h)] = cost;
+					successor_[Index(t, h)] = h;
+					edge_id_[Index(t, h)] = EdgeID(i, req, false);
+					if(compute_demand_) {
+						demand_[Index(t, h)] = g_->GetDeadheadDemand(i, req);
+					}
+				}
+				cost = g_->GetReverseDeadheadCost(i, req);
+				if (cost < distance_[Index(h, t)]) {
+					distance_[Index(h, t)] = cost;
+					successor_[Index(h, t)] = t;
+					edge_id_[Index(h, t)] = EdgeID(i, req, true);
+					if(compute_demand_) {
+						demand_[Index(h, t)] = g_->GetReverseDeadheadDemand(i, req);
+					}
+				}
+			}
 		}
 
-		void APSP_Deadheading() {
-			double cost = kDoubleMax;
-			for(size_t i = 0; i < n_; ++i) {
-				distance_[i][i] = 0;
+		/* Results loaded from the cache are read-only */
+		void CopyFromCache() {
+			if(distance_data_ == distance_.data()) {
+				return;
 			}
+			const size_t matrix_size = n_ * n_;
+			distance_.assign(distance_data_, distance_data_ + matrix_size);
+			successor_.assign(successor_data_, successor_data_ + matrix_size);
+			edge_id_.assign(edge_id_data_, edge_id_data_ + matrix_size);
 			if(compute_demand_) {
-				for(size_t i = 0; i < n_; ++i) {
-					demand_[i][i] = 0;
+				demand_.assign(demand_data_, demand_data_ + matrix_size);
+			}
+			distance_data_ = distance_.data();
+			demand_data_ = demand_.data();
+			successor_data_ = successor_.data();
+			edge_id_data_ = edge_id_.data();
+			cache_.Close();
+		}
+
+		/* Picks the cheapest edge from u to v again; ties go to the first edge, as in InitializeEdges() */
+		void UpdateEdgeID(const size_t u, const size_t v) {
+			CostType cost = kInfinity;
+			uint32_t id = kNIL32;
+			for(size_t a = arcs_->GetArcsBegin(u); a < arcs_->GetArcsEnd(u); ++a) {
+				const auto &arc = arcs_->GetArc(a);
+				if(arc.head_ == v and CostType(arc.cost_) < cost) {
+					cost = arc.cost_;
+					id = EdgeID(arc.edge_index_, arc.edge_->GetReq(), arc.rev_);
 				}
 			}
-			for(size_t i = 0; i < m_; ++i) {
-				size_t t, h;
-				g_->GetVerticesIndexOfEdge(i, t, h, kIsRequired);
-				cost = g_->GetDeadheadCost(i, kIsRequired);
-				if (cost < distance_[t][h]) {
-					distance_[t][h] = cost;
-					helper_edge_[t][h] = MakeEdgeTuple(g_->GetEdge(i, kIsRequired), false);
-					if(compute_demand_) {
-						demand_[t][h] = g_->GetDeadheadDemand(i, kIsRequired);
+			edge_id_[Index(u, v)] = id;
+		}
+
+		/* Computes row i again with Dijkstra; successors are the first vertices of the paths in the shortest path tree */
+		void RecomputeRow(const size_t i, std::vector <double> &distance, std::vector <double> &demand, std::vector <size_t> &pred_arc) {
+			Dijkstra(*arcs_, i, distance.data(), compute_demand_ ? demand.data() : nullptr, pred_arc.data());
+			uint32_t *successor_i = &successor_[Index(i, 0)];
+			std::fill(successor_i, successor_i + n_, kNIL32);
+			std::vector <size_t> path;
+			for(size_t j = 0; j < n_; ++j) {
+				size_t v = j;
+				for(; pred_arc[v] != kNIL and successor_i[v] == kNIL32; v = arcs_->GetArc(pred_arc[v]).tail_) {
+					path.push_back(v);
+				}
+				uint32_t first = v == i ? kNIL32 : successor_i[v];
+				for(auto it = path.rbegin(); it != path.rend(); ++it) {
+					if(first == kNIL32) {
+						first = *it;
 					}
+					successor_i[*it] = first;
 				}
-				cost = g_->GetReverseDeadheadCost(i, kIsRequired);
-				if (cost < distance_[h][t]) {
-					distance_[h][t] = cost;
-					helper_edge_[h][t] = MakeEdgeTuple(g_->GetEdge(i, kIsRequired), true);
-					if(compute_demand_) {
-						demand_[h][t] = g_->GetReverseDeadheadDemand(i, kIsRequired);
+				path.clear();
+				distance_[Index(i, j)] = distance[j] == kDoubleMax ? kInfinity : CostType(distance[j]);
+				if(compute_demand_) {
+					demand_[Index(i, j)] = distance[j] == kDoubleMax ? kInfinity : CostType(demand[j]);
+				}
+			}
+			distance_[Index(i, i)] = 0;
+		}
+
+		template <bool with_demand>
+			void SnapshotRow(const size_t k, const size_t j0) {
+				const size_t j_end = std::min(j0 + kBlockSize, n_);
+				const size_t s = (k % kBlockSize) * n_;
+				std::copy(&distance_[Index(k, j0)], &distance_[Index(k, j_end)], &row_snapshot_[s + j0]);
+				if(with_demand) {
+					std::copy(&demand_[Index(k, j0)], &demand_[Index(k, j_end)], &row_demand_snapshot_[s + j0]);
+				}
+			}
+
+		template <bool with_demand>
+			void SnapshotColumn(const size_t k, const size_t i0) {
+				const size_t i_end = std::min(i0 + kBlockSize, n_);
+				const size_t s = (k % kBlockSize) * n_;
+				for(size_t i = i0; i < i_end; ++i) {
+					column_snapshot_[s + i] = distance_[Index(i, k)];
+					column_successor_snapshot_[s + i] = successor_[Index(i, k)];
+					if(with_demand) {
+						column_demand_snapshot_[s + i] = demand_[Index(i, k)];
 					}
 				}
 			}
-			for(size_t i = 0; i < m_nr_; ++i) {
-				size_t t, h;
-				g_->GetVerticesIndexOfEdge(i, t, h, kIsNotRequired);
-				cost = g_->GetDeadheadCost(i, kIsNotRequired);
-				if (cost < distance_[t][h]) {
-					distance_[t][h] = cost;
-					helper_edge_[t][h] = MakeEdgeTuple(g_->GetEdge(i, kIsNotRequired), false);
-					if(compute_demand_) {
-						demand_[t][h] = g_->GetDeadheadDemand(i, kIsNotRequired);
+
+		/* Relaxes the tile with rows starting at i0 and columns starting at j0 through the intermediate vertex k. Each row is one call of the min-plus kernel. */
+		template <bool with_demand>
+			void RelaxBlock(const size_t i0, const size_t j0, const size_t k, const MinPlusRowFn <CostType> min_plus_row) {
+				const size_t i_end = std::min(i0 + kBlockSize, n_);
+				const size_t j_end = std::min(j0 + kBlockSize, n_);
+				const size_t s = (k % kBlockSize) * n_;
+				const CostType *distance_k = &row_snapshot_[s + j0];
+				const CostType *demand_k = with_demand ? &row_demand_snapshot_[s + j0] : nullptr;
+				for(size_t i = i0; i < i_end; ++i) {
+					const CostType distance_ik = column_snapshot_[s + i];
+					if(distance_ik == kInfinity) {
+						continue;
 					}
+					const CostType demand_ik = with_demand ? column_demand_snapshot_[s + i] : 0;
+					CostType *demand_i = with_demand ? &demand_[Index(i, j0)] : nullptr;
+					min_plus_row(distance_ik, distance_k, &distance_[Index(i, j0)], column_successor_snapshot_[s + i], &successor_[Index(i, j0)], demand_ik, demand_k, demand_i, j_end - j0);
 				}
-				cost = g_->GetReverseDeadheadCost(i, kIsNotRequired);
-				if (cost < distance_[h][t]) {
-					distance_[h][t] = cost;
-					helper_edge_[h][t] = MakeEdgeTuple(g_->GetEdge(i, kIsNotRequired), true);
-					if(compute_demand_) {
-						demand_[h][t] = g_->GetReverseDeadheadDemand(i, kIsNotRequired);
+			}
+
+		/* Each phase processes the diagonal tile, then the tiles in its row and column, then all remaining tiles. Tiles within the last two steps are independent and are distributed over the thread pool. */
+		template <bool with_demand>
+			void BlockedFloydWarshall() {
+				ThreadPool pool(options_.num_threads);
+				const MinPlusRowFn <CostType> min_plus_row = GetMinPlusRow<CostType, with_demand>();
+				row_snapshot_.resize(kBlockSize * n_);
+				column_snapshot_.resize(kBlockSize * n_);
+				column_successor_snapshot_.resize(kBlockSize * n_);
+				if(with_demand) {
+					row_demand_snapshot_.resize(kBlockSize * n_);
+					column_demand_snapshot_.resize(kBlockSize * n_);
+				}
+				const size_t num_blocks = (n_ + kBlockSize - 1) / kBlockSize;
+				for(size_t kb = 0; kb < num_blocks; ++kb) {
+					const size_t k0 = kb * kBlockSize;
+					const size_t k_end = std::min(k0 + kBlockSize, n_);
+					for(size_t k = k0; k < k_end; ++k) {
+						SnapshotRow<with_demand>(k, k0);
+						SnapshotColumn<with_demand>(k, k0);
+						RelaxBlock<with_demand>(k0, k0, k, min_plus_row);
 					}
+					pool.ParallelFor(0, num_blocks, [&](size_t b) {
+							if(b == kb) {
+								return;
+							}
+							const size_t b0 = b * kBlockSize;
+							for(size_t k = k0; k < k_end; ++k) {
+								SnapshotRow<with_demand>(k, b0);
+								RelaxBlock<with_demand>(k0, b0, k, min_plus_row);
+							}
+							for(size_t k = k0; k < k_end; ++k) {
+								SnapshotColumn<with_demand>(k, b0);
+								RelaxBlock<with_demand>(b0, k0, k, min_plus_row);
+							}
+							});
+					pool.ParallelFor(0, num_blocks, [&](size_t ib) {
+							if(ib == kb) {
+								return;
+							}
+							for(size_t jb = 0; jb < num_blocks; ++jb) {
+								if(jb == kb) {
+									continue;
+								}
+								for(size_t k = k0; k < k_end; ++k) {
+									RelaxBlock<with_demand>(ib * kBlockSize, jb * kBlockSize, k, min_plus_row);
+								}
+							}
+							});
 				}
+				AlignedVector <CostType>().swap(row_snapshot_);
+				AlignedVector <CostType>().swap(column_snapshot_);
+				AlignedVector <CostType>().swap(row_demand_snapshot_);
+				AlignedVector <CostType>().swap(column_demand_snapshot_);
+				AlignedVector <uint32_t>().swap(column_successor_snapshot_);
+			}
+
+		public:
+		/* The matrices hold vertex indices in 32 bits, with kNIL32 reserved, and edge indices in the 30 bits of EdgeID() */
+		static bool IsSupported(const std::shared_ptr <const Graph> &g) {
+			return g->GetN() < kNIL32 and std::max(g->GetM(), g->GetMnr()) < (size_t(1) << 30);
+		}
+
+		BasicAPSP_FloydWarshall(const std::shared_ptr <const Graph> &g) : BasicAPSP_FloydWarshall(g, false) {}
+
+		BasicAPSP_FloydWarshall(const std::shared_ptr <const Graph> &g, bool compute_demand) : BasicAPSP_FloydWarshall(g, compute_demand, APSP_Options()) {}
+
+		BasicAPSP_FloydWarshall(const std::shared_ptr <const Graph> &g, bool compute_demand, const APSP_Options &options) : g_{g}, demand_requested_{compute_demand}, options_{options} {
+			n_ = g_->GetN();
+			m_ = g_->GetM();
+			m_nr_ = g_->GetMnr();
+			is_supported_ = IsSupported(g_);
+			if(not is_supported_) {
+				std::cerr << "Graph too large for APSP_FloydWarshall\n";
 			}
+		}
 
-			for(size_t k = 0; k < n_; ++k) {
+		bool APSP_Deadheading() {
+			if(not is_supported_) {
+				return kFail;
+			}
+			arcs_ = std::make_unique <DeadheadArcs> (g_);
+			SetDemandMode();
+			const size_t matrix_size = n_ * n_;
+			std::vector <size_t> section_bytes{matrix_size * sizeof(CostType), compute_demand_ ? matrix_size * sizeof(CostType) : 0, matrix_size * sizeof(uint32_t), matrix_size * sizeof(uint32_t)};
+			std::string cache_filename;
+			uint64_t cache_key = 0;
+			if(not options_.cache_dir.empty()) {
+				cache_key = APSP_CacheKey(g_, options_, "floyd_warshall", sizeof(CostType), compute_demand_);
+				cache_filename = APSP_Cache::GetFilename(options_.cache_dir, "floyd_warshall", cache_key);
+				if(cache_.Load(cache_filename, cache_key, section_bytes) == kSuccess) {
+					distance_data_ = static_cast <const CostType *> (cache_.GetSection(0));
+					demand_data_ = static_cast <const CostType *> (cache_.GetSection(1));
+					successor_data_ = static_cast <const uint32_t *> (cache_.GetSection(2));
+					edge_id_data_ = static_cast <const uint32_t *> (cache_.GetSection(3));
+					return kSuccess;
+				}
+			}
+
+			Initialize();
+			for(size_t i = 0; i < n_; ++i) {
+				distance_[Index(i, i)] = 0;
+			}
+			if(compute_demand_) {
 				for(size_t i = 0; i < n_; ++i) {
-					for(size_t j = 0; j < n_; ++j) {
-						if(distance_[i][k] + distance_[k][j] < distance_[i][j]) {
-							distance_[i][j] = distance_[i][k] + distance_[k][j];
-							helper_[i][j] = k;
-							if(compute_demand_) {
-								demand_[i][j] = demand_[i][k] + demand_[k][j];
+					demand_[Index(i, i)] = 0;
+				}
+			}
+			InitializeEdges(m_, kIsRequired);
+			InitializeEdges(m_nr_, kIsNotRequired);
+
+			if(compute_demand_) {
+				BlockedFloydWarshall<true>();
+			} else {
+				BlockedFloydWarshall<false>();
+			}
+			distance_data_ = distance_.data();
+			demand_data_ = demand_.data();
+			successor_data_ = successor_.data();
+			edge_id_data_ = edge_id_.data();
+			if(not cache_filename.empty()) {
+				APSP_Cache::Write(cache_filename, cache_key, {{distance_data_, section_bytes[0]}, {demand_data_, section_bytes[1]}, {successor_data_, section_bytes[2]}, {edge_id_data_, section_bytes[3]}});
+			}
+			return kSuccess;
+		}
+
+		/* Rows in which an arc that became more expensive or changed demand lies on a shortest path are computed again with Dijkstra. Each arc that became cheaper is then inserted by relaxing d(i, u) + c + d(v, j) for the rows i it improves. */
+		bool UpdateDeadheadCosts() {
+			if(arcs_ == nullptr) {
+				std::cerr << "APSP_Deadheading must be called before UpdateDeadheadCosts\n";
+				return kFail;
+			}
+			std::vector <size_t> invalidating_arcs, decreased_arcs;
+			std::vector <double> old_costs(arcs_->GetNumArcs());
+			for(size_t a = 0; a < arcs_->GetNumArcs(); ++a) {
+				old_costs[a] = arcs_->GetArc(a).cost_;
+			}
+			arcs_->Update(invalidating_arcs, decreased_arcs);
+			if(invalidating_arcs.empty() and decreased_arcs.empty()) {
+				return kSuccess;
+			}
+			demand_memo_.Clear();
+			if(demand_requested_ and demand_is_cost_ != arcs_->DemandsEqualCosts()) {
+				return APSP_Deadheading();
+			}
+			CopyFromCache();
+			for(const auto *changed_arcs:{&invalidating_arcs, &decreased_arcs}) {
+				for(const auto &a:*changed_arcs) {
+					UpdateEdgeID(arcs_->GetArc(a).tail_, arcs_->GetArc(a).head_);
+				}
+			}
+
+			ThreadPool pool(options_.num_threads);
+			if(not invalidating_arcs.empty()) {
+				/* An arc is on a shortest path from i if it is tight; the tolerance absorbs the rounding of the matrix entries */
+				const double tolerance = 64 * std::numeric_limits<CostType>::epsilon();
+				pool.ParallelFor(0, n_, [&](size_t i) {
+						bool affected = false;
+						for(const auto &a:invalidating_arcs) {
+							const auto &arc = arcs_->GetArc(a);
+							const CostType distance_iu = distance_[Index(i, arc.tail_)];
+							const double distance_iv = distance_[Index(i, arc.head_)];
+							if(distance_iu != kInfinity and distance_iu + old_costs[a] <= distance_iv + tolerance * std::max(1.0, distance_iv)) {
+								affected = true;
+								break;
 							}
 						}
-					}
-				}
+						if(affected) {
+							std::vector <double> distance(n_), demand(compute_demand_ ? n_ : 0);
+							std::vector <size_t> pred_arc(n_);
+							RecomputeRow(i, distance, demand, pred_arc);
+						}
+						});
 			}
+
+			for(const auto &a:decreased_arcs) {
+				const auto &arc = arcs_->GetArc(a);
+				const size_t u = arc.tail_, v = arc.head_;
+				const CostType cost = arc.cost_;
+				const CostType demand_uv = compute_demand_ ? CostType(arc.demand_) : 0;
+				/* Row v and column u do not change while the arc is inserted */
+				pool.ParallelFor(0, n_, [&](size_t i) {
+						const CostType distance_iu = distance_[Index(i, u)];
+						if(distance_iu == kInfinity or not (distance_iu + cost < distance_[Index(i, v)])) {
+							return;
+						}
+						const CostType distance_iuv = distance_iu + cost;
+						const uint32_t successor_iu = i == u ? uint32_t(v) : successor_[Index(i, u)];
+						for(size_t j = 0; j < n_; ++j) {
+							const CostType distance_vj = distance_[Index(v, j)];
+							if(distance_vj != kInfinity and distance_iuv + distance_vj < distance_[Index(i, j)]) {
+								distance_[Index(i, j)] = distance_iuv + distance_vj;
+								successor_[Index(i, j)] = successor_iu;
+								if(compute_demand_) {
+									demand_[Index(i, j)] = demand_[Index(i, u)] + demand_uv + demand_[Index(v, j)];
+								}
+							}
+						}
+						});
+			}
+			return kSuccess;
 		}
 
 		void GetPath(std::vector < Edge > &edge_list, const size_t i, const size_t j) const {
-			std::vector <EdgeTuple> path;
-			GetPath(path, i, j);
-			for(auto &[e, is_rev] : path) {
-				if(e == nullptr)
-					continue;
-				Edge new_edge = *e;
-				new_edge.SetReq(kIsNotRequired);
-				if(is_rev) {
-					new_edge.SetCost(e->GetReverseDeadheadCost());
-					new_edge.Reverse();
-				}
-				else {
-					new_edge.SetCost(e->GetDeadheadCost());
+			for(size_t u = i; u != j; ) {
+				uint32_t v = successor_data_[Index(u, j)];
+				if(v == kNIL32) {
+					break;
 				}
-				edge_list.push_back(new_edge);
+				uint32_t id = edge_id_data_[Index(u, v)];
+				AddDeadheadEdge(edge_list, g_->GetEdge(id >> 2, id & 2), id & 1);
+				u = v;
 			}
 		}
 
 		double GetCost(const size_t i, const size_t j) const {
-			return distance_[i][j];
+			CostType cost = distance_data_[Index(i, j)];
+			return cost == kInfinity ? kDoubleMax : cost;
 		}
 
 		double GetDemand(const size_t i, const size_t j) const {
-			return demand_[i][j];
+			if(demand_is_cost_) {
+				return GetCost(i, j);
+			}
+			if(lazy_demand_) {
+				return GetPathDemand(i, j);
+			}
+			if(not compute_demand_) {
+				return kDoubleNaN;
+			}
+			CostType demand = demand_data_[Index(i, j)];
+			return demand == kInfinity ? kDoubleMax : demand;
+		}
+
+		size_t MemoryFootprint() const {
+			size_t bytes = VectorBytes(distance_) + VectorBytes(demand_) + VectorBytes(successor_) + VectorBytes(edge_id_);
+			bytes += VectorBytes(row_snapshot_) + VectorBytes(column_snapshot_) + VectorBytes(row_demand_snapshot_) + VectorBytes(column_demand_snapshot_) + VectorBytes(column_successor_snapshot_);
+			if(arcs_ != nullptr) {
+				bytes += arcs_->MemoryFootprint();
+			}
+			return bytes + demand_memo_.MemoryFootprint();
 		}
 
 	};
 
+	typedef BasicAPSP_FloydWarshall <double> APSP_FloydWarshall;
+	typedef BasicAPSP_FloydWarshall <float> APSP_FloydWarshallFloat;
+
 } // namespace lclibrary
 
 #endif /* LCLIBRARY_ALGORITHMS_APSP_FLOYDWARSHALL_H_ */
@@ -0,0 +1,173 @@
+/**
+ * This file is part of the LineCoverage-library.
+ * The file contains all pair shortest paths computed one source at a time on first use and kept in a bounded cache
+ *
+ * TODO:
+ *
+ * @author Saurav Agarwal
+ * @contact sagarw10@uncc.edu
+ * @contact agr.saurav1@gmail.com
+ * Repository: https://github.com/UNCCharlotte-Robotics/LineCoverage-library
+ *
+ * Copyright (C) 2020--2022 University of North Carolina at Charlotte.
+ * The LineCoverage-library is owned by the University of North Carolina at Charlotte and is protected by United States copyright laws and applicable international treaties and/or conventions.
+ *
+ * The LineCoverage-library is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * DISCLAIMER OF WARRANTIES: THE SOFTWARE IS PROVIDED "AS-IS" WITHOUT WARRANTY OF ANY KIND INCLUDING ANY WARRANTIES OF PERFORMANCE OR MERCHANTABILITY OR FITNESS FOR A PARTICULAR USE OR PURPOSE OR OF NON-INFRINGEMENT. YOU BEAR ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE SOFTWARE OR HARDWARE.
+ *
+ * SUPPORT AND MAINTENANCE: No support, installation, or training is provided.
+ *
+ * You should have received a copy of the GNU General Public License along with LineCoverage-library. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LCLIBRARY_ALGORITHMS_APSP_LAZY_H_
+#define LCLIBRARY_ALGORITHMS_APSP_LAZY_H_
+
+#include <lclibrary/core/constants.h>
+#include <lclibrary/core/graph.h>
+#include <lclibrary/algorithms/apsp_base.h>
+#include <lclibrary/algorithms/dijkstra.h>
+#include <memory>
+#include <list>
+#include <mutex>
+#include <algorithm>
+
+namespace lclibrary {
+
+	/* Rows of the distance matrix are computed with Dijkstra when a source is first queried. The least recently used rows are evicted once the cache exceeds APSP_Options::cache_memory_mb, so memory use does not grow with n^2. */
+	class APSP_Lazy : public APSP {
+		struct Row {
+			size_t source_;
+			std::vector <double> distance_;
+			std::vector <double> demand_;
+			std::vector <size_t> pred_arc_;
+		};
+
+		std::shared_ptr <const Graph> g_;
+		size_t n_;
+		DeadheadArcs arcs_;
+		bool demand_requested_ = false;
+		/* Rows store demands unless demands equal costs */
+		bool compute_demand_ = false;
+		bool demand_is_cost_ = false;
+		APSP_Options options_;
+		size_t max_rows_ = 1;
+
+		/* Most recently used row first */
+		mutable std::list <Row> rows_;
+		mutable std::vector <std::list <Row>::iterator> row_of_source_;
+		mutable std::mutex mutex_;
+
+		/* Cached rows are dropped, as their demands may not match the new mode */
+		void SetDemandMode() {
+			demand_is_cost_ = demand_requested_ and arcs_.DemandsEqualCosts();
+			compute_demand_ = demand_requested_ and not demand_is_cost_;
+			size_t row_bytes = n_ * (sizeof(double) + sizeof(size_t) + (compute_demand_ ? sizeof(double) : 0));
+			if(row_bytes > 0) {
+				max_rows_ = std::max(size_t(1), (options_.cache_memory_mb << 20) / row_bytes);
+			}
+			rows_.clear();
+			row_of_source_.assign(n_, rows_.end());
+		}
+
+		/* Must be called with mutex_ held */
+		const Row &GetRow(const size_t i) const {
+			auto it = row_of_source_[i];
+			if(it != rows_.end()) {
+				rows_.splice(rows_.begin(), rows_, it);
+				return rows_.front();
+			}
+			if(rows_.size() < max_rows_) {
+				rows_.emplace_front();
+				rows_.front().distance_.resize(n_);
+				rows_.front().pred_arc_.resize(n_);
+				if(compute_demand_) {
+					rows_.front().demand_.resize(n_);
+				}
+			} else {
+				row_of_source_[rows_.back().source_] = rows_.end();
+				rows_.splice(rows_.begin(), rows_, std::prev(rows_.end()));
+			}
+			Row &row = rows_.front();
+			row.source_ = i;
+			row_of_source_[i] = rows_.begin();
+			Dijkstra(arcs_, i, row.distance_.data(), compute_demand_ ? row.demand_.data() : nullptr, row.pred_arc_.data());
+			return row;
+		}
+
+		public:
+		APSP_Lazy(const std::shared_ptr <const Graph> &g) : APSP_Lazy(g, false) {}
+
+		APSP_Lazy(const std::shared_ptr <const Graph> &g, bool compute_demand) : APSP_Lazy(g, compute_demand, APSP_Options()) {}
+
+		APSP_Lazy(const std::shared_ptr <const Graph> &g, bool compute_demand, const APSP_Options &options) : g_{g}, n_{g->GetN()}, arcs_(g), demand_requested_{compute_demand}, options_{options} {
+			SetDemandMode();
+		}
+
+		/* Nothing is computed up front */
+		bool APSP_Deadheading() {
+			return kSuccess;
+		}
+
+		void GetPath(std::vector < Edge > &edge_list, const size_t i, const size_t j) const {
+			std::lock_guard <std::mutex> lock(mutex_);
+			const Row &row = GetRow(i);
+			std::vector <size_t> path;
+			GetTreePath(arcs_, row.pred_arc_.data(), j, path);
+			for(const auto &a:path) {
+				const auto &arc = arcs_.GetArc(a);
+				AddDeadheadEdge(edge_list, arc.edge_, arc.rev_);
+			}
+		}
+
+		double GetCost(const size_t i, const size_t j) const {
+			std::lock_guard <std::mutex> lock(mutex_);
+			return GetRow(i).distance_[j];
+		}
+
+		double GetDemand(const size_t i, const size_t j) const {
+			if(demand_is_cost_) {
+				return GetCost(i, j);
+			}
+			if(not compute_demand_) {
+				return kDoubleNaN;
+			}
+			std::lock_guard <std::mutex> lock(mutex_);
+			return GetRow(i).demand_[j];
+		}
+
+		/* Cached rows are repaired in place, others are computed with the new costs when queried */
+		bool UpdateDeadheadCosts() {
+			std::lock_guard <std::mutex> lock(mutex_);
+			std::vector <size_t> invalidating_arcs, decreased_arcs;
+			arcs_.Update(invalidating_arcs, decreased_arcs);
+			if(demand_requested_ and demand_is_cost_ != arcs_.DemandsEqualCosts()) {
+				SetDemandMode();
+				return kSuccess;
+			}
+			for(auto &row:rows_) {
+				UpdateShortestPathTree(arcs_, invalidating_arcs, decreased_arcs, row.distance_.data(), compute_demand_ ? row.demand_.data() : nullptr, row.pred_arc_.data());
+			}
+			return kSuccess;
+		}
+
+		size_t GetNumCachedRows() const {
+			std::lock_guard <std::mutex> lock(mutex_);
+			return rows_.size();
+		}
+
+		size_t MemoryFootprint() const {
+			std::lock_guard <std::mutex> lock(mutex_);
+			size_t bytes = arcs_.MemoryFootprint() + ListBytes(rows_) + VectorBytes(row_of_source_);
+			for(const auto &row:rows_) {
+				bytes += VectorBytes(row.distance_) + VectorBytes(row.demand_) + VectorBytes(row.pred_arc_);
+			}
+			return bytes;
+		}
+
+	};
+
+} // namespace lclibrary
+
+#endif /* LCLIBRARY_ALGORITHMS_APSP_LAZY_H_ */
@@ -0,0 +1,237 @@
+/**
+ * This file is part of the LineCoverage-library.
+ * The file contains the all pair shortest paths between the terminal vertices, i.e., endpoints of required edges and depots
+ *
+ * TODO:
+ *
+ * @author Saurav Agarwal
+ * @contact sagarw10@uncc.edu
+ * @contact agr.saurav1@gmail.com
+ * Repository: https://github.com/UNCCharlotte-Robotics/LineCoverage-library
+ *
+ * Copyright (C) 2020--2022 University of North Carolina at Charlotte.
+ * The LineCoverage-library is owned by the University of North Carolina at Charlotte and is protected by United States copyright laws and applicable international treaties and/or conventions.
+ *
+ * The LineCoverage-library is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * DISCLAIMER OF WARRANTIES: THE SOFTWARE IS PROVIDED "AS-IS" WITHOUT WARRANTY OF ANY KIND INCLUDING ANY WARRANTIES OF PERFORMANCE OR MERCHANTABILITY OR FITNESS FOR A PARTICULAR USE OR PURPOSE OR OF NON-INFRINGEMENT. YOU BEAR ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE SOFTWARE OR HARDWARE.
+ *
+ * SUPPORT AND MAINTENANCE: No support, installation, or training is provided.
+ *
+ * You should have received a copy of the GNU General Public License along with LineCoverage-library. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LCLIBRARY_ALGORITHMS_APSP_TERMINALS_H_
+#define LCLIBRARY_ALGORITHMS_APSP_TERMINALS_H_
+
+#include <lclibrary/core/constants.h>
+#include <lclibrary/core/graph.h>
+#include <lclibrary/algorithms/apsp_base.h>
+#include <lclibrary/algorithms/apsp_cache.h>
+#include <lclibrary/algorithms/dijkstra.h>
+#include <lclibrary/utils/thread_pool.h>
+#include <memory>
+#include <vector>
+
+namespace lclibrary {
+
+	/* Indices of the vertices incident to required edges and of the depots, in increasing order */
+	inline void GetTerminalVertices(const std::shared_ptr <const Graph> &g, std::vector <size_t> &terminals) {
+		std::vector <bool> is_terminal(g->GetN(), false);
+		for(size_t i = 0; i < g->GetM(); ++i) {
+			size_t t, h;
+			g->GetVerticesIndexOfEdge(i, t, h, kIsRequired);
+			is_terminal[t] = is_terminal[h] = true;
+		}
+		if(g->IsDepotSet()) {
+			is_terminal[g->GetDepot()] = true;
+		}
+		std::vector <size_t> depot_indices;
+		g->GetDepotIndices(depot_indices);
+		for(const auto &d:depot_indices) {
+			is_terminal[d] = true;
+		}
+		terminals.clear();
+		for(size_t v = 0; v < g->GetN(); ++v) {
+			if(is_terminal[v]) {
+				terminals.push_back(v);
+			}
+		}
+	}
+
+	/* The solvers only query shortest paths between terminal vertices, which are often a small fraction of the vertices of road networks. Distances (and demands) are stored in a dense matrix over the terminals, filled by Dijkstra from each terminal. Queries take vertex indices; a query from or to a non-terminal vertex runs Dijkstra on demand. Paths are recovered with a point-to-point Dijkstra. */
+	class APSP_Terminals : public APSP {
+		std::shared_ptr <const Graph> g_;
+		size_t n_;
+		DeadheadArcs arcs_;
+		std::vector <size_t> terminals_;
+		std::vector <size_t> terminal_index_; /* Index of a vertex in terminals_, kNIL for other vertices */
+		size_t num_terminals_;
+		std::vector <double> distance_;
+		std::vector <double> demand_;
+		bool demand_requested_ = false;
+		/* The demand matrix is not stored if demands equal costs */
+		bool compute_demand_ = false;
+		bool demand_is_cost_ = false;
+		APSP_Options options_;
+		/* Point either to the matrices above or to the sections of a mapped cache file */
+		APSP_Cache cache_;
+		const double *distance_data_ = nullptr;
+		const double *demand_data_ = nullptr;
+
+		inline size_t Index(const size_t i, const size_t j) const {
+			return i * num_terminals_ + j;
+		}
+
+		void SetDemandMode() {
+			demand_is_cost_ = demand_requested_ and arcs_.DemandsEqualCosts();
+			compute_demand_ = demand_requested_ and not demand_is_cost_;
+		}
+
+		/* Runs Dijkstra from i until j is reached */
+		void ShortestPath(const size_t i, const size_t j, std::vector <double> &distance, std::vector <double> &demand, std::vector <size_t> &pred_arc) const {
+			distance.resize(n_);
+			pred_arc.resize(n_);
+			if(compute_demand_) {
+				demand.resize(n_);
+			}
+			Dijkstra(arcs_, i, distance.data(), compute_demand_ ? demand.data() : nullptr, pred_arc.data(), j);
+		}
+
+		/* Dijkstra from each terminal */
+		void ComputeMatrix() {
+			const size_t matrix_size = num_terminals_ * num_terminals_;
+			distance_.resize(matrix_size);
+			if(compute_demand_) {
+				demand_.resize(matrix_size);
+			}
+			ThreadPool pool(options_.num_threads);
+			pool.ParallelFor(0, num_terminals_, [&](size_t k) {
+					std::vector <double> distance(n_), demand(compute_demand_ ? n_ : 0);
+					std::vector <size_t> pred_arc(n_);
+					Dijkstra(arcs_, terminals_[k], distance.data(), compute_demand_ ? demand.data() : nullptr, pred_arc.data());
+					for(size_t l = 0; l < num_terminals_; ++l) {
+						distance_[Index(k, l)] = distance[terminals_[l]];
+						if(compute_demand_) {
+							demand_[Index(k, l)] = demand[terminals_[l]];
+						}
+					}
+					});
+			distance_data_ = distance_.data();
+			demand_data_ = demand_.data();
+		}
+
+		public:
+		APSP_Terminals(const std::shared_ptr <const Graph> &g) : APSP_Terminals(g, false) {}
+
+		APSP_Terminals(const std::shared_ptr <const Graph> &g, bool compute_demand) : APSP_Terminals(g, compute_demand, APSP_Options()) {}
+
+		APSP_Terminals(const std::shared_ptr <const Graph> &g, bool compute_demand, const APSP_Options &options) : g_{g}, n_{g->GetN()}, arcs_(g), demand_requested_{compute_demand}, options_{options} {
+			GetTerminalVertices(g_, terminals_);
+			num_terminals_ = terminals_.size();
+			terminal_index_.assign(n_, kNIL);
+			for(size_t k = 0; k < num_terminals_; ++k) {
+				terminal_index_[terminals_[k]] = k;
+			}
+		}
+
+		bool APSP_Deadheading() {
+			SetDemandMode();
+			const size_t matrix_size = num_terminals_ * num_terminals_;
+			std::vector <size_t> section_bytes{matrix_size * sizeof(double), compute_demand_ ? matrix_size * sizeof(double) : 0};
+			std::string cache_filename;
+			uint64_t cache_key = 0;
+			/* The matrices are indexed by terminals_, which depends on the depots as well as the graph */
+			const uint64_t terminal_fingerprint = VertexSubsetFingerprint(terminals_);
+			if(not options_.cache_dir.empty()) {
+				cache_key = APSP_CacheKey(g_, options_, "terminals", sizeof(double), compute_demand_, terminal_fingerprint);
+				cache_filename = APSP_Cache::GetFilename(options_.cache_dir, "terminals", cache_key);
+				if(cache_.Load(cache_filename, cache_key, section_bytes, terminal_fingerprint) == kSuccess) {
+					distance_data_ = static_cast <const double *> (cache_.GetSection(0));
+					demand_data_ = static_cast <const double *> (cache_.GetSection(1));
+					return kSuccess;
+				}
+			}
+
+			ComputeMatrix();
+			if(not cache_filename.empty()) {
+				APSP_Cache::Write(cache_filename, cache_key, {{distance_data_, section_bytes[0]}, {demand_data_, section_bytes[1]}}, terminal_fingerprint);
+			}
+			return kSuccess;
+		}
+
+		/* Without the shortest path trees it is not known which terminal pairs a changed arc affects, so the matrix is computed again */
+		bool UpdateDeadheadCosts() {
+			if(distance_data_ == nullptr) {
+				std::cerr << "APSP_Deadheading must be called before UpdateDeadheadCosts\n";
+				return kFail;
+			}
+			std::vector <size_t> invalidating_arcs, decreased_arcs;
+			arcs_.Update(invalidating_arcs, decreased_arcs);
+			if(invalidating_arcs.empty() and decreased_arcs.empty()) {
+				return kSuccess;
+			}
+			SetDemandMode();
+			ComputeMatrix();
+			cache_.Close();
+			return kSuccess;
+		}
+
+		void GetPath(std::vector < Edge > &edge_list, const size_t i, const size_t j) const {
+			std::vector <double> distance, demand;
+			std::vector <size_t> pred_arc;
+			ShortestPath(i, j, distance, demand, pred_arc);
+			std::vector <size_t> path;
+			GetTreePath(arcs_, pred_arc.data(), j, path);
+			for(const auto &a:path) {
+				const auto &arc = arcs_.GetArc(a);
+				AddDeadheadEdge(edge_list, arc.edge_, arc.rev_);
+			}
+		}
+
+		double GetCost(const size_t i, const size_t j) const {
+			const size_t k = terminal_index_[i], l = terminal_index_[j];
+			if(k != kNIL and l != kNIL) {
+				return distance_data_[Index(k, l)];
+			}
+			std::vector <double> distance, demand;
+			std::vector <size_t> pred_arc;
+			ShortestPath(i, j, distance, demand, pred_arc);
+			return distance[j];
+		}
+
+		double GetDemand(const size_t i, const size_t j) const {
+			if(demand_is_cost_) {
+				return GetCost(i, j);
+			}
+			if(not compute_demand_) {
+				return kDoubleNaN;
+			}
+			const size_t k = terminal_index_[i], l = terminal_index_[j];
+			if(k != kNIL and l != kNIL) {
+				return demand_data_[Index(k, l)];
+			}
+			std::vector <double> distance, demand;
+			std::vector <size_t> pred_arc;
+			ShortestPath(i, j, distance, demand, pred_arc);
+			return demand[j];
+		}
+
+		size_t GetNumTerminals() const {
+			return num_terminals_;
+		}
+
+		/* kNIL if the vertex is not a terminal */
+		size_t GetTerminalIndex(const size_t v) const {
+			return terminal_index_[v];
+		}
+
+		size_t MemoryFootprint() const {
+			return arcs_.MemoryFootprint() + VectorBytes(terminals_) + VectorBytes(terminal_index_) + VectorBytes(distance_) + VectorBytes(demand_);
+		}
+
+	};
+
+} // namespace lclibrary
+
+#endif /* LCLIBRARY_ALGORITHMS_APSP_TERMINALS_H_ */
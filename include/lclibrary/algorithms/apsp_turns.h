@@ -26,13 +26,17 @@
 #define LCLIBRARY_ALGORITHMS_APSP_TURNS_H_
 
 #include <memory>
+#include <queue>
+#include <cmath>
 #include <unordered_map>
 #include <lclibrary/core/constants.h>
 #include <lclibrary/core/typedefs.h>
 #include <lclibrary/core/vertex.h>
 #include <lclibrary/core/graph.h>
 #include <lclibrary/algorithms/apsp_base.h>
+#include <lclibrary/utils/thread_pool.h>
 #include <lclibrary/utils/edge_cost_with_circular_turns.h>
+#include <lclibrary/utils/turn_cost_table.h>
 
 namespace lclibrary {
 
@@ -49,12 +53,9 @@ namespace lclibrary {
 			bool req_;
 			bool rev_;
 			size_t t_ID_, h_ID_;
+			size_t t_, h_; /* Vertex indices of the tail and the head */
 			size_t g_index_;
 			double deadhead_cost_ = kDoubleMax;
-			std::vector <size_t> outgoing_arcs_;
-			std::vector <double> out_req_cost_;
-			std::vector <size_t> incoming_arcs_;
-			std::vector <double> in_req_turn_cost_;
 			ArcData(const Edge* e, bool req_in, bool rev_in, size_t t, size_t h) : edge_(e), req_(req_in), rev_(rev_in), t_ID_(t), h_ID_(h) {}
 		};
 
@@ -66,24 +67,174 @@ namespace lclibrary {
 
 		struct DepotData {
 			size_t ID_;
-			std::vector <size_t> outgoing_arcs_;
-			std::vector <size_t> incoming_arcs_;
+			size_t index_;
 			std::vector <ShortestPathReq> distance_depot_to_req_;
 			std::vector <ShortestPathReq> distance_req_to_depot_;
-			DepotData(size_t id):ID_(id) {}
+			DepotData(size_t id, size_t index):ID_(id), index_(index) {}
 		};
 
 		std::shared_ptr <const EdgeCost_CircularTurns> cost_fn_;
 		std::vector <size_t> depots_IDs_;
 		std::unordered_map <size_t, size_t> depot_map_; /*! Stores a map of the index of depots to actual ID of the depot <ID, index>*/
 
-		std::vector <std::vector <double> > distance_;
 		std::vector <std::vector <ShortestPathReq> > distance_req_;
-		std::vector <std::vector <size_t> > helper_;
-		std::vector <std::vector < EdgeTuple> > helper_edge_;
 
 		std::vector <ArcData> all_arcs_;
 		std::vector <DepotData> depots_;
+		APSP_Options options_;
+
+		/* Turning costs, and the arcs leaving and entering each vertex in compressed sparse row form */
+		std::shared_ptr <TurnCostTable> turn_costs_;
+		/* Arcs that can follow arc a, i.e., leave its head, except those that go back to its tail. Required arcs come first, so out_req_cost_ covers the prefix of out_arcs_ that belongs to them. */
+		std::vector <size_t> out_offsets_, out_arcs_;
+		std::vector <double> out_deadhead_cost_; /* Turning and deadheading cost of each outgoing arc when deadheading arc a */
+		std::vector <double> out_req_cost_; /* Turning and deadheading cost of each outgoing arc after servicing arc a */
+		std::vector <double> opposite_req_cost_; /* Cost of deadheading the opposite arc after servicing a required arc */
+		/* The incoming arcs of required arc i are the arcs entering its tail; in_req_turn_cost_[in_offsets_[i] + k] is the turning cost from the k-th of them into servicing arc i */
+		std::vector <size_t> in_offsets_;
+		std::vector <double> in_req_turn_cost_;
+		/* Required arcs, other than arc i itself, that can be serviced right after required arc i */
+		std::vector <size_t> serv_offsets_, serv_arcs_;
+		std::vector <double> serv_turn_cost_;
+
+		inline size_t GetOpposite(const size_t i) const {
+			return i < m_ ? m_ + i : i - m_;
+		}
+
+		/* Dijkstra on the line graph: the nodes are the arcs, and moving from an arc to an outgoing arc costs the turn plus deadheading the outgoing arc. cost[a] is the cost of reaching the head of arc a, pred[a] the previous arc and root[a] the source arc the path starts from. Stops once target is settled unless target is kNIL. */
+		void ArcDijkstra(const std::vector <std::pair <size_t, double> > &sources, std::vector <double> &cost, std::vector <size_t> &pred, std::vector <size_t> &root, const size_t target = kNIL) const {
+			cost.assign(num_deadheading_arcs_, kDoubleMax);
+			pred.assign(num_deadheading_arcs_, kNIL);
+			root.assign(num_deadheading_arcs_, kNIL);
+			typedef std::pair <double, size_t> QueueElement;
+			std::priority_queue <QueueElement, std::vector <QueueElement>, std::greater <QueueElement> > queue;
+			for(const auto &[arc, arc_cost]:sources) {
+				if(arc_cost < cost[arc]) {
+					cost[arc] = arc_cost;
+					root[arc] = arc;
+					queue.push(QueueElement(arc_cost, arc));
+				}
+			}
+			while(not queue.empty()) {
+				auto [arc_cost, a] = queue.top();
+				queue.pop();
+				if(arc_cost > cost[a]) {
+					continue;
+				}
+				if(a == target) {
+					return;
+				}
+				for(size_t out_iter = out_offsets_[a]; out_iter < out_offsets_[a + 1]; ++out_iter) {
+					size_t b = out_arcs_[out_iter];
+					double new_cost = arc_cost + out_deadhead_cost_[out_iter];
+					if(new_cost < cost[b]) {
+						cost[b] = new_cost;
+						pred[b] = a;
+						root[b] = root[a];
+						queue.push(QueueElement(new_cost, b));
+					}
+				}
+			}
+		}
+
+		/* Shortest paths from required arc i, after servicing it, to all required arcs and to the depots */
+		void ComputeFromRequiredArc(const size_t i) {
+			const ArcData& arc_i = all_arcs_[i];
+			std::vector <std::pair <size_t, double> > sources;
+			sources.reserve(out_offsets_[i + 1] - out_offsets_[i] + 1);
+			for(size_t out_iter = out_offsets_[i]; out_iter < out_offsets_[i + 1]; ++out_iter) {
+				sources.push_back(std::make_pair(out_arcs_[out_iter], out_req_cost_[out_iter]));
+			}
+			sources.push_back(std::make_pair(GetOpposite(i), opposite_req_cost_[i]));
+			std::vector <double> cost;
+			std::vector <size_t> pred, root;
+			ArcDijkstra(sources, cost, pred, root);
+
+			distance_req_[i][i].cost_ = 0; // cost to itself is 0
+			distance_req_[i][i].status_ = -1;
+			for(size_t serv_iter = serv_offsets_[i]; serv_iter < serv_offsets_[i + 1]; ++serv_iter) { // If the required arcs are connected then get direct cost
+				size_t j = serv_arcs_[serv_iter];
+				distance_req_[i][j].cost_ = serv_turn_cost_[serv_iter];
+				distance_req_[i][j].status_ = 0;
+			}
+
+			for(size_t j = 0; j < 2 * m_; ++j) {
+				if(i == j) {
+					continue;
+				}
+				auto &path_def = distance_req_[i][j];
+				const ArcData& arc_j = all_arcs_[j];
+				const double *in_turn_cost = &in_req_turn_cost_[in_offsets_[j]];
+				for(size_t in_iter = turn_costs_->GetInBegin(arc_j.t_); in_iter < turn_costs_->GetInEnd(arc_j.t_); ++in_iter, ++in_turn_cost) { // check for each incoming arc to j
+					size_t in_j = turn_costs_->GetInArc(in_iter);
+					if(cost[in_j] == kDoubleMax) {
+						continue;
+					}
+					double path_cost = cost[in_j] + *in_turn_cost;
+					if(path_cost < path_def.cost_) {
+						path_def.cost_ = path_cost;
+						path_def.status_ = 2;
+						path_def.start_deadheading_ = root[in_j];
+						path_def.end_deadheading_ = in_j;
+					}
+				}
+			}
+
+			for(auto &depot:depots_) {
+				auto &path_def = depot.distance_req_to_depot_[i];
+				if(arc_i.h_ID_ == depot.ID_) { // Depot lies on head, cost to depot is 0
+					path_def.cost_ = 0;
+					path_def.status_ = 0;
+					continue;
+				}
+				for(size_t in_iter = turn_costs_->GetInBegin(depot.index_); in_iter < turn_costs_->GetInEnd(depot.index_); ++in_iter) {
+					size_t in_depot = turn_costs_->GetInArc(in_iter);
+					if(cost[in_depot] < path_def.cost_) {
+						path_def.cost_ = cost[in_depot];
+						path_def.status_ = 2;
+						path_def.start_deadheading_ = root[in_depot];
+						path_def.end_deadheading_ = in_depot;
+					}
+				}
+			}
+		}
+
+		/* Shortest paths from the depot to all required arcs */
+		void ComputeFromDepot(DepotData &depot) {
+			std::vector <std::pair <size_t, double> > sources;
+			sources.reserve(turn_costs_->GetOutEnd(depot.index_) - turn_costs_->GetOutBegin(depot.index_));
+			for(size_t out_iter = turn_costs_->GetOutBegin(depot.index_); out_iter < turn_costs_->GetOutEnd(depot.index_); ++out_iter) {
+				size_t out_depot_index = turn_costs_->GetOutArc(out_iter);
+				sources.push_back(std::make_pair(out_depot_index, all_arcs_[out_depot_index].deadhead_cost_));
+			}
+			std::vector <double> cost;
+			std::vector <size_t> pred, root;
+			ArcDijkstra(sources, cost, pred, root);
+
+			for(size_t i = 0; i < 2 * m_; ++i) {
+				const auto &arc_i = all_arcs_[i];
+				auto &path_def = depot.distance_depot_to_req_[i];
+				if(arc_i.t_ID_ == depot.ID_) { // Depot lies on tail, cost from depot is 0
+					path_def.cost_ = 0;
+					path_def.status_ = 0;
+					continue;
+				}
+				const double *in_turn_cost = &in_req_turn_cost_[in_offsets_[i]];
+				for(size_t in_iter = turn_costs_->GetInBegin(arc_i.t_); in_iter < turn_costs_->GetInEnd(arc_i.t_); ++in_iter, ++in_turn_cost) {
+					size_t in_req = turn_costs_->GetInArc(in_iter);
+					if(cost[in_req] == kDoubleMax) {
+						continue;
+					}
+					double path_cost = cost[in_req] + *in_turn_cost;
+					if(path_cost < path_def.cost_) {
+						path_def.cost_ = path_cost;
+						path_def.status_ = 2;
+						path_def.start_deadheading_ = root[in_req];
+						path_def.end_deadheading_ = in_req;
+					}
+				}
+			}
+		}
 
 		void GenerateAllDeadheadingArcs() {
 			for(size_t reqi = 0; reqi < m_; ++reqi) {
@@ -92,6 +243,7 @@ namespace lclibrary {
 				all_arcs_.push_back(ArcData(g_->GetEdge(reqi, kIsRequired), kIsRequired, false, t, h));
 				all_arcs_[reqi].deadhead_cost_ = g_->GetDeadheadCost(reqi, kIsRequired);
 				all_arcs_[reqi].g_index_ = reqi;
+				g_->GetVerticesIndexOfEdge(reqi, all_arcs_[reqi].t_, all_arcs_[reqi].h_, kIsRequired);
 			}
 			for(size_t reqi = 0; reqi < m_; ++reqi) {
 				size_t t, h;
@@ -99,6 +251,7 @@ namespace lclibrary {
 				all_arcs_.push_back(ArcData(g_->GetEdge(reqi, kIsRequired), kIsRequired, true, h, t));
 				all_arcs_[m_ + reqi].deadhead_cost_ = g_->GetReverseDeadheadCost(reqi, kIsRequired);
 				all_arcs_[m_ + reqi].g_index_ = reqi;
+				g_->GetVerticesIndexOfEdge(reqi, all_arcs_[m_ + reqi].h_, all_arcs_[m_ + reqi].t_, kIsRequired);
 			}
 			for(size_t nreqi = 0; nreqi < m_nr_; ++nreqi) {
 				size_t t, h;
@@ -106,6 +259,7 @@ namespace lclibrary {
 				all_arcs_.push_back(ArcData(g_->GetEdge(nreqi, kIsNotRequired), kIsNotRequired, false, t, h));
 				all_arcs_[2 * m_ + nreqi].deadhead_cost_ = g_->GetDeadheadCost(nreqi, kIsNotRequired);
 				all_arcs_[2 * m_ + nreqi].g_index_ = nreqi;
+				g_->GetVerticesIndexOfEdge(nreqi, all_arcs_[2 * m_ + nreqi].t_, all_arcs_[2 * m_ + nreqi].h_, kIsNotRequired);
 			}
 			for(size_t nreqi = 0; nreqi < m_nr_; ++nreqi) {
 				size_t t, h;
@@ -113,6 +267,7 @@ namespace lclibrary {
 				all_arcs_.push_back(ArcData(g_->GetEdge(nreqi, kIsNotRequired), kIsNotRequired, true, h, t));
 				all_arcs_[2 * m_ + m_nr_ + nreqi].deadhead_cost_ = g_->GetReverseDeadheadCost(nreqi, kIsNotRequired);
 				all_arcs_[2 * m_ + m_nr_ + nreqi].g_index_ = nreqi;
+				g_->GetVerticesIndexOfEdge(nreqi, all_arcs_[2 * m_ + m_nr_ + nreqi].h_, all_arcs_[2 * m_ + m_nr_ + nreqi].t_, kIsNotRequired);
 			}
 		}
 
@@ -133,50 +288,32 @@ namespace lclibrary {
 		}
 
 		void GenerateAdjacency() {
-			for(size_t i = 0; i < m_; ++i) {
-				ArcData& arc_i = all_arcs_[i];
-				ArcData& rev_arc_i = all_arcs_[m_ + i];
-				for(size_t j = 0; j < num_deadheading_arcs_; ++j) {
-					const ArcData& arc_j = all_arcs_[j];
-					if(arc_j.t_ID_ == arc_i.h_ID_) {
-						if(arc_j.h_ID_ != arc_i.t_ID_) { // don't add if twin opposite arc
-							arc_i.outgoing_arcs_.push_back(j);
-						}
-					}
-
-					if(arc_j.t_ID_ == arc_i.t_ID_) { // for the opposite arc
-						if(arc_j.h_ID_ != arc_i.h_ID_) { // don't add if twin opposite arc
-							rev_arc_i.outgoing_arcs_.push_back(j);
-						}
-					}
-
-					if(arc_j.h_ID_ == arc_i.t_ID_) {
-						arc_i.incoming_arcs_.push_back(j);
-					}
-
-					if(arc_j.h_ID_ == arc_i.h_ID_) {
-						rev_arc_i.incoming_arcs_.push_back(j);
+			out_offsets_.assign(num_deadheading_arcs_ + 1, 0);
+			out_arcs_.clear();
+			for(size_t i = 0; i < num_deadheading_arcs_; ++i) {
+				const ArcData& arc_i = all_arcs_[i];
+				for(size_t k = turn_costs_->GetOutBegin(arc_i.h_); k < turn_costs_->GetOutEnd(arc_i.h_); ++k) {
+					size_t j = turn_costs_->GetOutArc(k);
+					if(all_arcs_[j].h_ != arc_i.t_) { // don't add if twin opposite arc
+						out_arcs_.push_back(j);
 					}
 				}
+				out_offsets_[i + 1] = out_arcs_.size();
 			}
 
-			for(size_t i = 0; i < m_nr_; ++i) {
-				ArcData& arc_i = all_arcs_[2 * m_ + i];
-				ArcData& rev_arc_i = all_arcs_[2 * m_ + m_nr_ + i];
-				for(size_t j = 0; j < num_deadheading_arcs_; ++j) {
-					const ArcData& arc_j = all_arcs_[j];
-					if(arc_j.t_ID_ == arc_i.h_ID_) {
-						if(arc_j.h_ID_ != arc_i.t_ID_) {
-							arc_i.outgoing_arcs_.push_back(j);
-						}
-					}
-
-					if(arc_j.t_ID_ == arc_i.t_ID_) {
-						if(arc_j.h_ID_ != arc_i.h_ID_) {
-							rev_arc_i.outgoing_arcs_.push_back(j);
-						}
+			in_offsets_.assign(2 * m_ + 1, 0);
+			serv_offsets_.assign(2 * m_ + 1, 0);
+			serv_arcs_.clear();
+			for(size_t i = 0; i < 2 * m_; ++i) {
+				const ArcData& arc_i = all_arcs_[i];
+				in_offsets_[i + 1] = in_offsets_[i] + turn_costs_->GetInEnd(arc_i.t_) - turn_costs_->GetInBegin(arc_i.t_);
+				for(size_t k = turn_costs_->GetOutBegin(arc_i.h_); k < turn_costs_->GetOutEnd(arc_i.h_); ++k) {
+					size_t j = turn_costs_->GetOutArc(k);
+					if(j < 2 * m_ and j != i) {
+						serv_arcs_.push_back(j);
 					}
 				}
+				serv_offsets_[i + 1] = serv_arcs_.size();
 			}
 		}
 
@@ -190,211 +327,110 @@ namespace lclibrary {
 			for(size_t i = 0; i < n_depots_; ++i) {
 				std::cout << "GetDepots: " << depots_IDs_[i] << std::endl;
 				depot_map_[depots_IDs_[i]] = i;
-				depots_.push_back(DepotData(depots_IDs_[i]));
+				depots_.push_back(DepotData(depots_IDs_[i], depot_indices[i]));
 				depots_[i].distance_depot_to_req_.resize(2 * m_);
 				depots_[i].distance_req_to_depot_.resize(2 * m_);
-				for(size_t j = 0; j < num_deadheading_arcs_; ++j) {
-					if(all_arcs_[j].t_ID_ == depots_IDs_[i]) {
-						depots_[i].outgoing_arcs_.push_back(j);
-					}
-					if(all_arcs_[j].h_ID_ == depots_IDs_[i]) {
-						depots_[i].incoming_arcs_.push_back(j);
-					}
-				}
 			}
 		}
 
 		void Initialize() {
 			all_arcs_.reserve(num_deadheading_arcs_);
-			distance_.resize(num_deadheading_arcs_, std::vector <double> (num_deadheading_arcs_, kDoubleMax));
 			distance_req_.resize(2 * m_, std::vector <ShortestPathReq> (2 * m_));
-			helper_.resize(num_deadheading_arcs_, std::vector <size_t> (num_deadheading_arcs_, kNIL));
-			/* helper_edge_.resize(num_deadheading_arcs_, std::vector <ArcData>(num_deadheading_arcs_)); */
-		}
-
-		void GetPath(std::vector < EdgeTuple > &path, size_t i, size_t j) const {
-			if(helper_[i][j] == kNIL)
-				path.push_back(helper_edge_[i][j]);
-			else {
-				GetPath(path, i, helper_[i][j]);
-				GetPath(path, helper_[i][j], j);
-			}
 		}
 
 		public:
-		APSP_Turns(std::shared_ptr <const Graph> g, std::shared_ptr <const EdgeCost_CircularTurns> &cost_fn) : g_{g} {
+		APSP_Turns(std::shared_ptr <const Graph> g, std::shared_ptr <const EdgeCost_CircularTurns> &cost_fn) : APSP_Turns(g, cost_fn, APSP_Options()) {}
+
+		APSP_Turns(std::shared_ptr <const Graph> g, std::shared_ptr <const EdgeCost_CircularTurns> &cost_fn, const APSP_Options &options) : g_{g}, options_{options} {
 			cost_fn_ = cost_fn;
 			n_ = g_->GetN();
 			m_ = g_->GetM();
 			m_nr_ = g_->GetMnr();
 			num_deadheading_arcs_ = 2 * m_ + 2 * m_nr_;
 			Initialize();
+			turn_costs_ = std::make_shared <TurnCostTable> (g_, cost_fn_);
 			GenerateAllDeadheadingArcs();
 			GenerateAdjacency();
 			GetDepots();
 		}
 
+		/* Only the required arcs and the depots are queried, so instead of all pairs of arcs, the line graph is searched from each required arc and each depot. The searches are distributed over a thread pool. */
 		bool APSP_Deadheading() {
 
-			for(size_t i = 0; i < num_deadheading_arcs_; ++i) { // set cost to self to 0
-				distance_[i][i] = 0;
-			}
-
+			turn_costs_->ComputeTurnCosts(options_.num_threads);
+			out_deadhead_cost_.resize(out_arcs_.size());
 			for(size_t i = 0; i < num_deadheading_arcs_; ++i) { // Get distances for adjacent edges
-				const auto &arc_i = all_arcs_[i];
-				for(const auto j:arc_i.outgoing_arcs_) {
-					const auto &arc_j = all_arcs_[j];
-					double turn_cost = kDoubleMax;
-					if(cost_fn_->ComputeTurnCost(arc_i.edge_, arc_j.edge_, false, false, arc_i.rev_, arc_j.rev_, turn_cost)) {
+				for(size_t out_iter = out_offsets_[i]; out_iter < out_offsets_[i + 1]; ++out_iter) {
+					const auto &arc_j = all_arcs_[out_arcs_[out_iter]];
+					double turn_cost = turn_costs_->GetTurnCost(i, out_arcs_[out_iter], false, false);
+					if(std::isnan(turn_cost)) {
 						return kFail;
 					}
-					double cost = turn_cost + arc_j.deadhead_cost_;
-					if(cost < distance_[i][j]) {
-						distance_[i][j] = cost;
-					}
+					out_deadhead_cost_[out_iter] = turn_cost + arc_j.deadhead_cost_;
 				}
 			}
 
-			for(size_t k = 0; k < num_deadheading_arcs_; ++k) { // n^3 iterations Floyd-Warshall
-				for(size_t i = 0; i < num_deadheading_arcs_; ++i) {
-					for(size_t j = 0; j < num_deadheading_arcs_; ++j) {
-						if(distance_[i][k] + distance_[k][j] < distance_[i][j]) {
-							distance_[i][j] = distance_[i][k] + distance_[k][j];
-							helper_[i][j] = k;
-						}
-					}
-				}
-			}
-
-			for(size_t i = 0; i < m_; ++i) { // Add opposite arcs to outgoing
-				all_arcs_[i].outgoing_arcs_.push_back(m_ + i);
-				all_arcs_[m_ + i].outgoing_arcs_.push_back(i);
-			}
-
 			// Compute cost of going from a required arc to an adjacent deadheading arc
 			// The cost includes the turning cost and the deadheading cost of the adjacent arc
+			out_req_cost_.resize(out_offsets_[2 * m_]);
+			opposite_req_cost_.resize(2 * m_);
 			for(size_t i = 0; i < 2 * m_; ++i) {
-				ArcData& req_arc_i = all_arcs_[i];
-				req_arc_i.out_req_cost_.clear();
-				req_arc_i.out_req_cost_.reserve(req_arc_i.outgoing_arcs_.size());
-				for(const auto &out_arc_j:req_arc_i.outgoing_arcs_) {
-					const auto &out_arc = all_arcs_[out_arc_j];
-					double turn_cost;
-					if(cost_fn_->ComputeTurnCost(req_arc_i.edge_, out_arc.edge_, true, false, req_arc_i.rev_, out_arc.rev_, turn_cost)) {
+				for(size_t out_iter = out_offsets_[i]; out_iter < out_offsets_[i + 1]; ++out_iter) {
+					const auto &out_arc = all_arcs_[out_arcs_[out_iter]];
+					double turn_cost = turn_costs_->GetTurnCost(i, out_arcs_[out_iter], true, false);
+					if(std::isnan(turn_cost)) {
 						return kFail;
 					}
-					double out_cost = out_arc.deadhead_cost_;
-					req_arc_i.out_req_cost_.push_back(turn_cost + out_cost);
+					out_req_cost_[out_iter] = turn_cost + out_arc.deadhead_cost_;
 				}
+				const auto &opposite_arc = all_arcs_[GetOpposite(i)];
+				double turn_cost = turn_costs_->GetTurnCost(i, GetOpposite(i), true, false);
+				if(std::isnan(turn_cost)) {
+					return kFail;
+				}
+				opposite_req_cost_[i] = turn_cost + opposite_arc.deadhead_cost_;
 			}
 
 			// Compute cost of going into a required arc from an adjacent deadheading arc
 			// The cost includes only the turning cost
+			in_req_turn_cost_.resize(in_offsets_[2 * m_]);
 			for(size_t i = 0; i < 2 * m_; ++i) {
-				ArcData& req_arc = all_arcs_[i];
-				req_arc.in_req_turn_cost_.reserve(req_arc.incoming_arcs_.size());
-				for(const auto &in_arc:req_arc.incoming_arcs_) {
-					double turn_cost;
-					if(cost_fn_->ComputeTurnCost(all_arcs_[in_arc].edge_, req_arc.edge_, false, true, all_arcs_[in_arc].rev_, req_arc.rev_, turn_cost)) {
+				const ArcData& req_arc = all_arcs_[i];
+				double *in_turn_cost = &in_req_turn_cost_[in_offsets_[i]];
+				for(size_t in_iter = turn_costs_->GetInBegin(req_arc.t_); in_iter < turn_costs_->GetInEnd(req_arc.t_); ++in_iter, ++in_turn_cost) {
+					*in_turn_cost = turn_costs_->GetTurnCost(turn_costs_->GetInArc(in_iter), i, false, true);
+					if(std::isnan(*in_turn_cost)) {
 						return kFail;
 					}
-					req_arc.in_req_turn_cost_.push_back(turn_cost);
 				}
 			}
 
-			for(size_t i = 0; i < 2 * m_; ++i) { // Compute shortest path from a required edge to another
-				const ArcData& arc_i = all_arcs_[i];
-				for(size_t j = 0; j < 2 * m_; ++j) {
-					if(i == j) { // cost to itself is 0
-						distance_req_[i][j].cost_ = 0;
-						distance_req_[i][j].status_ = -1;
-						continue;
-					}
-
-					const ArcData& arc_j = all_arcs_[j];
-					if(arc_i.h_ID_ == arc_j.t_ID_) { // If the required arcs are connected then get direct cost
-						double turn_cost;
-						if(cost_fn_->ComputeTurnCost(arc_i.edge_, arc_j.edge_, true, true, arc_i.rev_, arc_j.rev_, turn_cost)) {
-							return kFail;
-						}
-						distance_req_[i][j].cost_ = turn_cost;
-						distance_req_[i][j].status_ = 0;
-					}
-
-					for(size_t out_iter = 0; out_iter < arc_i.outgoing_arcs_.size(); ++out_iter) { // check for each outgoing arc from i
-						size_t out_i = arc_i.outgoing_arcs_[out_iter];
-						double out_cost = arc_i.out_req_cost_[out_iter];
-
-						for(size_t in_iter = 0; in_iter < arc_j.incoming_arcs_.size(); ++in_iter) { // check for each incoming arc to j
-							size_t in_j = arc_j.incoming_arcs_[in_iter];
-							double turn_cost = arc_j.in_req_turn_cost_[in_iter];
-							double cost = out_cost + distance_[out_i][in_j] + turn_cost;
-							if(cost < distance_req_[i][j].cost_) {
-								distance_req_[i][j].cost_ = cost;
-								distance_req_[i][j].status_ = 2;
-								distance_req_[i][j].start_deadheading_ = out_i;
-								distance_req_[i][j].end_deadheading_ = in_j;
-							}
-						}
+			// Compute cost of servicing a required arc directly after another
+			serv_turn_cost_.resize(serv_arcs_.size());
+			for(size_t i = 0; i < 2 * m_; ++i) {
+				for(size_t serv_iter = serv_offsets_[i]; serv_iter < serv_offsets_[i + 1]; ++serv_iter) {
+					serv_turn_cost_[serv_iter] = turn_costs_->GetTurnCost(i, serv_arcs_[serv_iter], true, true);
+					if(std::isnan(serv_turn_cost_[serv_iter])) {
+						return kFail;
 					}
 				}
 			}
 
-			for(auto &depot:depots_) {
-				for(size_t i = 0; i < 2 * m_; ++i) {
-					const auto &arc_i = all_arcs_[i];
-					if(arc_i.t_ID_ == depot.ID_) { // Depot lies on tail, cost from depot is 0
-						depot.distance_depot_to_req_[i].cost_ = 0;
-						depot.distance_depot_to_req_[i].status_ = 0;
-						continue;
+			ThreadPool pool(options_.num_threads);
+			pool.ParallelFor(0, 2 * m_ + n_depots_, [&](size_t i) {
+					if(i < 2 * m_) {
+						ComputeFromRequiredArc(i);
+					} else {
+						ComputeFromDepot(depots_[i - 2 * m_]);
 					}
-
-					for(const auto &out_depot_index:depot.outgoing_arcs_) { // Compute cost from depot to req arc
-						const auto &out_depot_arc = all_arcs_[out_depot_index];
-						double out_cost = out_depot_arc.deadhead_cost_;
-
-						for(size_t in_iter = 0; in_iter < arc_i.incoming_arcs_.size(); ++in_iter) {
-							size_t in_req = arc_i.incoming_arcs_[in_iter];
-							double turn_cost = arc_i.in_req_turn_cost_[in_iter];
-							double cost = out_cost + distance_[out_depot_index][in_req] + turn_cost;
-							if(cost < depot.distance_depot_to_req_[i].cost_) {
-								depot.distance_depot_to_req_[i].cost_ = cost;
-								depot.distance_depot_to_req_[i].status_ = 2;
-								depot.distance_depot_to_req_[i].start_deadheading_ = out_depot_index;
-								depot.distance_depot_to_req_[i].end_deadheading_ = in_req;
-							}
-						}
-					}
-				}
-
-				for(size_t i = 0; i < 2 * m_; ++i) {
-					const auto &arc_i = all_arcs_[i];
-					if(arc_i.h_ID_ == depot.ID_) { // Depot lies on head, cost to depot is 0
-						depot.distance_req_to_depot_[i].cost_ = 0;
-						depot.distance_req_to_depot_[i].status_ = 0;
-						continue;
-					}
-
-					for(size_t out_iter = 0; out_iter < arc_i.outgoing_arcs_.size(); ++out_iter) { // compute cost from req arc to depot
-						size_t out_i = arc_i.outgoing_arcs_[out_iter];
-						double out_cost = arc_i.out_req_cost_[out_iter];
-
-						for(const auto &in_depot:depot.incoming_arcs_) {
-							double cost = out_cost + distance_[out_i][in_depot];
-							if(cost < depot.distance_req_to_depot_[i].cost_) {
-								depot.distance_req_to_depot_[i].cost_ = cost;
-								depot.distance_req_to_depot_[i].status_ = 2;
-								depot.distance_req_to_depot_[i].start_deadheading_ = out_i;
-								depot.distance_req_to_depot_[i].end_deadheading_ = in_depot;
-							}
-						}
-					}
-
-				}
-			}
+					});
 			return kSuccess;
 		}
 
+		std::shared_ptr <const TurnCostTable> GetTurnCostTable() const {
+			return turn_costs_;
+		}
+
 		double GetDepotToRequiredCost(size_t depot_ID, size_t req_index, bool reverse) const {
 			size_t arc_index = EdgeToIndex(req_index, kIsRequired, reverse);
 			size_t depot_index;
@@ -487,50 +523,65 @@ namespace lclibrary {
 			GetDeadheadingPath(path_def.start_deadheading_, path_def.end_deadheading_, path);
 		}
 
-		void GetDeadheadingPathAux(const size_t i, const size_t j, std::vector <GraphEdge> &path) const {
-			if(helper_[i][j] == kNIL) {
-				path.push_back(GraphEdge(all_arcs_[i].g_index_, all_arcs_[i].req_, all_arcs_[i].rev_, false));
-			} else {
-				GetDeadheadingPathAux(i, helper_[i][j], path);
-				GetDeadheadingPathAux(helper_[i][j], j, path);
-			}
-		}
-
+		/* Arcs i to j, both included, along the shortest deadheading path between them */
 		void GetDeadheadingPath(const size_t i, const size_t j, std::vector <GraphEdge> &path) const {
 			if(i == j) {
 				path.push_back(GraphEdge(all_arcs_[i].g_index_, all_arcs_[i].req_, all_arcs_[i].rev_, false));
 				return;
 			}
-			if(helper_[i][j] == kNIL) {
-				path.push_back(GraphEdge(all_arcs_[i].g_index_, all_arcs_[i].req_, all_arcs_[i].rev_, false));
-				path.push_back(GraphEdge(all_arcs_[j].g_index_, all_arcs_[j].req_, all_arcs_[j].rev_, false));
-			} else {
-				GetDeadheadingPathAux(i, j, path);
-				path.push_back(GraphEdge(all_arcs_[j].g_index_, all_arcs_[j].req_, all_arcs_[j].rev_, false));
+			std::vector <double> cost;
+			std::vector <size_t> pred, root;
+			ArcDijkstra({std::make_pair(i, 0.)}, cost, pred, root, j);
+			if(cost[j] == kDoubleMax) {
+				std::cerr << "No deadheading path between arcs " << i << " and " << j << std::endl;
+				return;
+			}
+			std::vector <size_t> arcs;
+			for(size_t a = j; a != kNIL; a = pred[a]) {
+				arcs.push_back(a);
+			}
+			for(auto it = arcs.rbegin(); it != arcs.rend(); ++it) {
+				const auto &arc = all_arcs_[*it];
+				path.push_back(GraphEdge(arc.g_index_, arc.req_, arc.rev_, false));
 			}
 		}
 
+		/* Deadheading edges after arc i up to and including arc j */
 		void GetPath(std::vector < Edge > &edge_list, const size_t i, const size_t j) const {
-			std::vector <EdgeTuple> path;
-			GetPath(path, i, j);
-			for(auto &[e, is_rev] : path) {
-				if(e == nullptr)
-					continue;
-				Edge new_edge = *e;
-				new_edge.SetReq(kIsNotRequired);
-				if(is_rev) {
-					new_edge.SetCost(e->GetReverseDeadheadCost());
-					new_edge.Reverse();
-				}
-				else {
-					new_edge.SetCost(e->GetDeadheadCost());
-				}
-				edge_list.push_back(new_edge);
+			if(i == j) {
+				return;
+			}
+			std::vector <GraphEdge> path;
+			GetDeadheadingPath(i, j, path);
+			for(size_t k = 1; k < path.size(); ++k) {
+				AddDeadheadEdge(edge_list, g_->GetEdge(path[k].edge_index_, path[k].req_), path[k].rev_);
 			}
 		}
 
+		/* Cost of reaching the head of arc j from the head of arc i */
 		double GetCost(const size_t i, const size_t j) const {
-			return distance_[i][j];
+			if(i == j) {
+				return 0;
+			}
+			std::vector <double> cost;
+			std::vector <size_t> pred, root;
+			ArcDijkstra({std::make_pair(i, 0.)}, cost, pred, root, j);
+			return cost[j];
+		}
+
+		size_t MemoryFootprint() const {
+			size_t bytes = VectorBytes(depots_IDs_) + HashMapBytes(depot_map_) + VectorBytes(distance_req_) + VectorBytes(all_arcs_) + VectorBytes(depots_);
+			for(const auto &row:distance_req_) {
+				bytes += VectorBytes(row);
+			}
+			for(const auto &depot:depots_) {
+				bytes += VectorBytes(depot.distance_depot_to_req_) + VectorBytes(depot.distance_req_to_depot_);
+			}
+			if(turn_costs_ != nullptr) {
+				bytes += turn_costs_->MemoryFootprint();
+			}
+			bytes += VectorBytes(out_offsets_) + VectorBytes(out_arcs_) + VectorBytes(out_deadhead_cost_) + VectorBytes(out_req_cost_) + VectorBytes(opposite_req_cost_);
+			return bytes + VectorBytes(in_offsets_) + VectorBytes(in_req_turn_cost_) + VectorBytes(serv_offsets_) + VectorBytes(serv_arcs_) + VectorBytes(serv_turn_cost_);
 		}
 
 	};
@@ -39,8 +39,8 @@ namespace lclibrary {
 
 	class ConnectedComponents {
 		std::shared_ptr <const Graph> g_;
-		std::vector <const Vertex *> vertex_list_;
-		std::vector <AdjacentEdgeList::const_iterator> adjacent_iterator_list_;
+		/* Next outgoing edge of each vertex to explore; required edges come before non-required edges */
+		std::vector <size_t> adjacent_position_list_;
 		std::vector <Color> vertex_color_list_;
 		std::vector <size_t> vertex_cc_;
 		std::vector <size_t> rep_vertices_;
@@ -49,15 +49,18 @@ namespace lclibrary {
 
 		void StronglyCCBalancedAux (size_t u) {
 			vertex_cc_[u] = cc_count_;
-			const Vertex *t_v, *h_v;
 			vertex_color_list_[u] = kGray;
-			size_t v;
-			const Edge *e = nullptr;
-			while (!vertex_list_[u]->IsAdjacencyEnd(adjacent_iterator_list_[u])) {
-				vertex_list_[u]->GetAdjacentEdge(e, adjacent_iterator_list_[u]);
-				++adjacent_iterator_list_[u];
-				e->GetVertices(t_v, h_v);
-				g_->GetVertexIndex(h_v->GetID(), v);
+			const IndexSpan req_edges = g_->GetOutEdges(u, kIsRequired);
+			const IndexSpan nonreq_edges = g_->GetOutEdges(u, kIsNotRequired);
+			size_t t, v;
+			while (adjacent_position_list_[u] < req_edges.size() + nonreq_edges.size()) {
+				const size_t p = adjacent_position_list_[u]++;
+				if(p < req_edges.size()) {
+					g_->GetVerticesIndexOfEdge(req_edges[p], t, v, kIsRequired);
+				}
+				else {
+					g_->GetVerticesIndexOfEdge(nonreq_edges[p - req_edges.size()], t, v, kIsNotRequired);
+				}
 				if (vertex_color_list_[v] == kWhite) {
 					StronglyCCBalancedAux(v);
 				}
@@ -69,14 +72,8 @@ namespace lclibrary {
 		public:
 		ConnectedComponents(const std::shared_ptr <const Graph> &g) : g_{g}, cc_count_{0} {
 			n_ = g_->GetN();
-			vertex_list_.reserve(n_);
-			for(size_t i = 0; i < n_; ++i) {
-				auto v = g_->GetVertex(i);
-				vertex_list_.push_back(v);
-				adjacent_iterator_list_.push_back(v->GetAdjacencyStart());
-				vertex_cc_.push_back(0);
-			}
-			n_ = vertex_list_.size();
+			adjacent_position_list_.assign(n_, 0);
+			vertex_cc_.assign(n_, 0);
 		}
 
 		/* Compute connected components for a balanced graph */
@@ -86,7 +83,7 @@ namespace lclibrary {
 				return 1;
 			}
 			for(size_t i = 0; i < n_; ++i) {
-				if (vertex_list_[i]->GetAdjListSize() > 0) {
+				if (g_->GetOutDegree(i) > 0) {
 					vertex_color_list_.push_back(kWhite);
 				}
 				else {
@@ -0,0 +1,299 @@
+/**
+ * This file is part of the LineCoverage-library.
+ * The file contains the deadheading arcs of a graph in compressed sparse row form and Dijkstra's algorithm over them
+ *
+ * TODO: Radix heap for integer costs
+ *
+ * @author Saurav Agarwal
+ * @contact sagarw10@uncc.edu
+ * @contact agr.saurav1@gmail.com
+ * Repository: https://github.com/UNCCharlotte-Robotics/LineCoverage-library
+ *
+ * Copyright (C) 2020--2022 University of North Carolina at Charlotte.
+ * The LineCoverage-library is owned by the University of North Carolina at Charlotte and is protected by United States copyright laws and applicable international treaties and/or conventions.
+ *
+ * The LineCoverage-library is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * DISCLAIMER OF WARRANTIES: THE SOFTWARE IS PROVIDED "AS-IS" WITHOUT WARRANTY OF ANY KIND INCLUDING ANY WARRANTIES OF PERFORMANCE OR MERCHANTABILITY OR FITNESS FOR A PARTICULAR USE OR PURPOSE OR OF NON-INFRINGEMENT. YOU BEAR ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE SOFTWARE OR HARDWARE.
+ *
+ * SUPPORT AND MAINTENANCE: No support, installation, or training is provided.
+ *
+ * You should have received a copy of the GNU General Public License along with LineCoverage-library. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LCLIBRARY_ALGORITHMS_DIJKSTRA_H_
+#define LCLIBRARY_ALGORITHMS_DIJKSTRA_H_
+
+#include <lclibrary/core/constants.h>
+#include <lclibrary/core/graph.h>
+#include <vector>
+#include <queue>
+#include <memory>
+#include <functional>
+#include <algorithm>
+
+namespace lclibrary {
+
+	/* Each edge of the graph gives a forward and a reverse arc with the deadheading cost and demand. Arcs of a vertex keep the order of the edge lists, required edges first. */
+	class DeadheadArcs {
+		public:
+			struct Arc {
+				size_t tail_;
+				size_t head_;
+				double cost_;
+				double demand_;
+				const Edge *edge_;
+				size_t edge_index_;
+				bool rev_;
+			};
+
+		private:
+			size_t n_;
+			std::vector <size_t> offsets_;
+			std::vector <Arc> arcs_;
+			std::vector <size_t> twins_; /* Arc of the same edge in the opposite direction */
+
+		public:
+			DeadheadArcs(const std::shared_ptr <const Graph> &g) {
+				n_ = g->GetN();
+				std::vector <Arc> unsorted_arcs;
+				unsorted_arcs.reserve(2 * (g->GetM() + g->GetMnr()));
+				for(bool req:{kIsRequired, kIsNotRequired}) {
+					size_t num_edges = req == kIsRequired ? g->GetM() : g->GetMnr();
+					for(size_t i = 0; i < num_edges; ++i) {
+						size_t t, h;
+						g->GetVerticesIndexOfEdge(i, t, h, req);
+						const Edge *e = g->GetEdge(i, req);
+						unsorted_arcs.push_back(Arc{t, h, g->GetDeadheadCost(i, req), g->GetDeadheadDemand(i, req), e, i, false});
+						unsorted_arcs.push_back(Arc{h, t, g->GetReverseDeadheadCost(i, req), g->GetReverseDeadheadDemand(i, req), e, i, true});
+					}
+				}
+
+				offsets_.assign(n_ + 1, 0);
+				for(const auto &arc:unsorted_arcs) {
+					++offsets_[arc.tail_ + 1];
+				}
+				for(size_t v = 0; v < n_; ++v) {
+					offsets_[v + 1] += offsets_[v];
+				}
+				arcs_.resize(unsorted_arcs.size());
+				twins_.resize(unsorted_arcs.size());
+				std::vector <size_t> next(offsets_.begin(), offsets_.end() - 1);
+				std::vector <size_t> position(unsorted_arcs.size());
+				for(size_t a = 0; a < unsorted_arcs.size(); ++a) {
+					position[a] = next[unsorted_arcs[a].tail_]++;
+					arcs_[position[a]] = unsorted_arcs[a];
+				}
+				for(size_t a = 0; a < unsorted_arcs.size(); ++a) {
+					twins_[position[a]] = position[a ^ 1];
+				}
+			}
+
+			/* True if the demand of every arc equals its cost, e.g. after Graph::SetDemandsToCosts(). The demand of every shortest path is then its cost. */
+			bool DemandsEqualCosts() const {
+				for(const auto &arc:arcs_) {
+					if(arc.demand_ != arc.cost_) {
+						return false;
+					}
+				}
+				return true;
+			}
+
+			/* Reads the deadheading costs and demands again from the edges. Arcs that became more expensive or whose demand changed are appended to invalidating_arcs, arcs that became cheaper to decreased_arcs; an arc can be in both. */
+			void Update(std::vector <size_t> &invalidating_arcs, std::vector <size_t> &decreased_arcs) {
+				for(size_t a = 0; a < arcs_.size(); ++a) {
+					Arc &arc = arcs_[a];
+					const double cost = arc.rev_ ? arc.edge_->GetReverseDeadheadCost() : arc.edge_->GetDeadheadCost();
+					const double demand = arc.rev_ ? arc.edge_->GetReverseDeadheadDemand() : arc.edge_->GetDeadheadDemand();
+					if(cost > arc.cost_ or demand != arc.demand_) {
+						invalidating_arcs.push_back(a);
+					}
+					if(cost < arc.cost_) {
+						decreased_arcs.push_back(a);
+					}
+					arc.cost_ = cost;
+					arc.demand_ = demand;
+				}
+			}
+
+			size_t GetN() const { return n_; }
+			size_t GetNumArcs() const { return arcs_.size(); }
+			size_t GetArcsBegin(const size_t v) const { return offsets_[v]; }
+			size_t GetArcsEnd(const size_t v) const { return offsets_[v + 1]; }
+			const Arc &GetArc(const size_t a) const { return arcs_[a]; }
+			/* The arcs into v are the twins of the arcs out of v */
+			size_t GetTwin(const size_t a) const { return twins_[a]; }
+
+			size_t MemoryFootprint() const {
+				return VectorBytes(offsets_) + VectorBytes(arcs_) + VectorBytes(twins_);
+			}
+	};
+
+	/* Single source shortest paths from source. Fills distance, the demand along each path (when demand is not null), and the last arc of each path (kNIL for the source and unreachable vertices). All arrays have size n. If target is given, stops once its path is final; other entries may then be incomplete. */
+	inline void Dijkstra(const DeadheadArcs &arcs, const size_t source, double *distance, double *demand, size_t *pred_arc, const size_t target = kNIL) {
+		typedef std::pair <double, size_t> HeapEntry;
+		const size_t n = arcs.GetN();
+		std::fill(distance, distance + n, kDoubleMax);
+		std::fill(pred_arc, pred_arc + n, kNIL);
+		if(demand != nullptr) {
+			std::fill(demand, demand + n, kDoubleMax);
+			demand[source] = 0;
+		}
+		distance[source] = 0;
+		std::priority_queue <HeapEntry, std::vector <HeapEntry>, std::greater <HeapEntry>> heap;
+		heap.push(HeapEntry(0, source));
+		while(not heap.empty()) {
+			auto [d, u] = heap.top();
+			heap.pop();
+			if(d > distance[u]) {
+				continue;
+			}
+			if(u == target) {
+				return;
+			}
+			for(size_t a = arcs.GetArcsBegin(u); a < arcs.GetArcsEnd(u); ++a) {
+				const auto &arc = arcs.GetArc(a);
+				double new_distance = d + arc.cost_;
+				if(new_distance < distance[arc.head_]) {
+					distance[arc.head_] = new_distance;
+					pred_arc[arc.head_] = a;
+					if(demand != nullptr) {
+						demand[arc.head_] = demand[u] + arc.demand_;
+					}
+					heap.push(HeapEntry(new_distance, arc.head_));
+				}
+			}
+		}
+	}
+
+	/* Repairs a shortest path tree from Dijkstra() after the costs of decreased_arcs went down. Only the vertices whose distance improves are visited. */
+	inline void DijkstraDecrease(const DeadheadArcs &arcs, const std::vector <size_t> &decreased_arcs, double *distance, double *demand, size_t *pred_arc) {
+		typedef std::pair <double, size_t> HeapEntry;
+		std::priority_queue <HeapEntry, std::vector <HeapEntry>, std::greater <HeapEntry>> heap;
+		auto relax = [&](const size_t a) {
+			const auto &arc = arcs.GetArc(a);
+			double new_distance = distance[arc.tail_] + arc.cost_;
+			if(new_distance < distance[arc.head_]) {
+				distance[arc.head_] = new_distance;
+				pred_arc[arc.head_] = a;
+				if(demand != nullptr) {
+					demand[arc.head_] = demand[arc.tail_] + arc.demand_;
+				}
+				heap.push(HeapEntry(new_distance, arc.head_));
+			}
+		};
+		for(const auto &a:decreased_arcs) {
+			if(distance[arcs.GetArc(a).tail_] != kDoubleMax) {
+				relax(a);
+			}
+		}
+		while(not heap.empty()) {
+			auto [d, u] = heap.top();
+			heap.pop();
+			if(d > distance[u]) {
+				continue;
+			}
+			for(size_t a = arcs.GetArcsBegin(u); a < arcs.GetArcsEnd(u); ++a) {
+				relax(a);
+			}
+		}
+	}
+
+	/* Repairs a shortest path tree from Dijkstra() after invalidating_arcs became more expensive or changed demand. The subtrees below those of the arcs that are in the tree are cleared and settled again from the rest of the tree. Other vertices are visited only if their distance improves. */
+	inline void DijkstraIncrease(const DeadheadArcs &arcs, const std::vector <size_t> &invalidating_arcs, double *distance, double *demand, size_t *pred_arc) {
+		std::vector <size_t> subtree;
+		for(const auto &a:invalidating_arcs) {
+			const size_t root = arcs.GetArc(a).head_;
+			if(pred_arc[root] != a or distance[root] == kDoubleMax) {
+				continue;
+			}
+			size_t first = subtree.size();
+			subtree.push_back(root);
+			distance[root] = kDoubleMax;
+			for(size_t k = first; k < subtree.size(); ++k) {
+				const size_t u = subtree[k];
+				for(size_t b = arcs.GetArcsBegin(u); b < arcs.GetArcsEnd(u); ++b) {
+					const size_t v = arcs.GetArc(b).head_;
+					if(pred_arc[v] == b and distance[v] != kDoubleMax) {
+						subtree.push_back(v);
+						distance[v] = kDoubleMax;
+					}
+				}
+			}
+		}
+		if(subtree.empty()) {
+			return;
+		}
+
+		typedef std::pair <double, size_t> HeapEntry;
+		std::priority_queue <HeapEntry, std::vector <HeapEntry>, std::greater <HeapEntry>> heap;
+		for(const auto &v:subtree) {
+			pred_arc[v] = kNIL;
+			if(demand != nullptr) {
+				demand[v] = kDoubleMax;
+			}
+		}
+		/* Vertices outside the subtrees keep their distances, so each subtree vertex starts from its best arc out of them */
+		for(const auto &v:subtree) {
+			for(size_t b = arcs.GetArcsBegin(v); b < arcs.GetArcsEnd(v); ++b) {
+				const size_t a = arcs.GetTwin(b);
+				const auto &arc = arcs.GetArc(a);
+				if(distance[arc.tail_] == kDoubleMax) {
+					continue;
+				}
+				double new_distance = distance[arc.tail_] + arc.cost_;
+				if(new_distance < distance[v]) {
+					distance[v] = new_distance;
+					pred_arc[v] = a;
+					if(demand != nullptr) {
+						demand[v] = demand[arc.tail_] + arc.demand_;
+					}
+				}
+			}
+			if(distance[v] != kDoubleMax) {
+				heap.push(HeapEntry(distance[v], v));
+			}
+		}
+		while(not heap.empty()) {
+			auto [d, u] = heap.top();
+			heap.pop();
+			if(d > distance[u]) {
+				continue;
+			}
+			for(size_t a = arcs.GetArcsBegin(u); a < arcs.GetArcsEnd(u); ++a) {
+				const auto &arc = arcs.GetArc(a);
+				double new_distance = d + arc.cost_;
+				if(new_distance < distance[arc.head_]) {
+					distance[arc.head_] = new_distance;
+					pred_arc[arc.head_] = a;
+					if(demand != nullptr) {
+						demand[arc.head_] = demand[u] + arc.demand_;
+					}
+					heap.push(HeapEntry(new_distance, arc.head_));
+				}
+			}
+		}
+	}
+
+	/* Brings the shortest path tree up to date after DeadheadArcs::Update() */
+	inline void UpdateShortestPathTree(const DeadheadArcs &arcs, const std::vector <size_t> &invalidating_arcs, const std::vector <size_t> &decreased_arcs, double *distance, double *demand, size_t *pred_arc) {
+		if(not invalidating_arcs.empty()) {
+			DijkstraIncrease(arcs, invalidating_arcs, distance, demand, pred_arc);
+		}
+		if(not decreased_arcs.empty()) {
+			DijkstraDecrease(arcs, decreased_arcs, distance, demand, pred_arc);
+		}
+	}
+
+	/* Arcs of the path from the root of the shortest path tree to j, in order of traversal */
+	inline void GetTreePath(const DeadheadArcs &arcs, const size_t *pred_arc, const size_t j, std::vector <size_t> &path) {
+		size_t first = path.size();
+		for(size_t a = pred_arc[j]; a != kNIL; a = pred_arc[arcs.GetArc(a).tail_]) {
+			path.push_back(a);
+		}
+		std::reverse(path.begin() + first, path.end());
+	}
+
+} // namespace lclibrary
+
+#endif /* LCLIBRARY_ALGORITHMS_DIJKSTRA_H_ */
@@ -62,34 +62,36 @@ inline Route EulerTourGeneration(const std::shared_ptr <const Graph> g, GraphTyp
 	auto m = g->GetM();
 	auto m_nr = g->GetMnr();
 
-	std::vector <std::vector <size_t>> adjacent_lists;
-	adjacent_lists.resize(n);
 	std::vector <EdgeType> edge_list;
-
-	size_t t, h;
+	edge_list.reserve(m + m_nr);
 	for(size_t i = 0; i < m; ++i) {
-		g->GetVerticesIndexOfEdge(i, t, h, kIsRequired);
-		EdgeType e(i, kIsRequired, false);
-		edge_list.push_back(e);
-		adjacent_lists[t].push_back(edge_list.size() - 1);
-		if (graph_type == kUndirectedGraph) {
-			adjacent_lists[h].push_back(edge_list.size() - 1);
-		}
+		edge_list.emplace_back(i, kIsRequired, false);
 	}
 	for(size_t i = 0; i < m_nr; ++i) {
-		g->GetVerticesIndexOfEdge(i, t, h, kIsNotRequired);
-		EdgeType e(i, kIsNotRequired, false);
-		edge_list.push_back(e);
-		adjacent_lists[t].push_back(edge_list.size() - 1);
-		if (graph_type == kUndirectedGraph) {
-			adjacent_lists[h].push_back(edge_list.size() - 1);
-		}
+		edge_list.emplace_back(i, kIsNotRequired, false);
 	}
 
+	/* Edges leaving v; in an undirected graph, edges with v at either end */
+	auto adjacent_edges = [&g, graph_type](const size_t v, const bool req) {
+		return graph_type == kDirectedGraph ? g->GetOutEdges(v, req) : g->GetIncidentEdges(v, req);
+	};
+	std::vector <size_t> adjacent_list_size(n);
+	for(size_t v = 0; v < n; ++v) {
+		adjacent_list_size[v] = adjacent_edges(v, kIsRequired).size() + adjacent_edges(v, kIsNotRequired).size();
+	}
+	/* Index in edge_list of the p-th adjacent edge of v; required edges come first */
+	auto adjacent_edge = [&adjacent_edges, m](const size_t v, const size_t p) {
+		const IndexSpan req_edges = adjacent_edges(v, kIsRequired);
+		if(p < req_edges.size()) {
+			return req_edges[p];
+		}
+		return m + adjacent_edges(v, kIsNotRequired)[p - req_edges.size()];
+	};
+
 	std::vector <size_t> adjacent_list_iterator;
 	adjacent_list_iterator.resize(n, 0);
 
-	const Vertex *t_v, *h_v;
+	size_t t, h;
 	g->GetVerticesIndexOfEdge(0, t, h, kIsRequired);
 	auto v = t;
 
@@ -97,8 +99,8 @@ inline Route EulerTourGeneration(const std::shared_ptr <const Graph> g, GraphTyp
 	std::list <RouteEdges::const_iterator> insert_route;
 	std::list <size_t> multi_vertex_list;
 	const Edge *e = nullptr;
-	while(adjacent_list_iterator[v] < adjacent_lists[v].size()) {
-		auto e_idx = adjacent_lists[v][adjacent_list_iterator[v]];
+	while(adjacent_list_iterator[v] < adjacent_list_size[v]) {
+		auto e_idx = adjacent_edge(v, adjacent_list_iterator[v]);
 		auto e_t = edge_list[e_idx];
 
 		e = g->GetEdge(e_t.e, e_t.type);
@@ -117,22 +119,21 @@ inline Route EulerTourGeneration(const std::shared_ptr <const Graph> g, GraphTyp
 			edge_list[e_idx].is_traversed = true;
 			auto route_it1 = route.AddEdge(e_new, route_it);
 
-			if(adjacent_list_iterator[v] < adjacent_lists[v].size()) {
+			if(adjacent_list_iterator[v] < adjacent_list_size[v]) {
 				multi_vertex_list.push_back(v);
 				insert_route.push_back(route_it1);
 			}
 
-			e_new.GetVertices(t_v, h_v);
-			g->GetVertexIndex(h_v->GetID(), v);
+			g->GetHeadVertexIndex(e_new, v);
 		}
 
-		while(adjacent_list_iterator[v] >= adjacent_lists[v].size() and multi_vertex_list.size() > 0) {
+		while(adjacent_list_iterator[v] >= adjacent_list_size[v] and multi_vertex_list.size() > 0) {
 			v = multi_vertex_list.front();
 			route_it = insert_route.front();
 			multi_vertex_list.pop_front();
 			insert_route.pop_front();
-			while(adjacent_list_iterator[v] < adjacent_lists[v].size()) {
-				auto idx = adjacent_lists[v][adjacent_list_iterator[v]];
+			while(adjacent_list_iterator[v] < adjacent_list_size[v]) {
+				auto idx = adjacent_edge(v, adjacent_list_iterator[v]);
 				if (edge_list[idx].is_traversed == true) {
 					++adjacent_list_iterator[v];
 					continue;
@@ -34,12 +34,13 @@
 #include <memory>
 #include <lclibrary/core/core.h>
 #include <lclibrary/utils/utils.h>
+#include <lclibrary/algorithms/apsp_base.h>
 #include <mcpm/graph.h>
 #include <mcpm/matching.h>
 
 namespace lclibrary{
 
-	inline void ComputeMatching(std::vector <int> vertex_degree_list, const std::shared_ptr <const APSP_FloydWarshall> &apsp, std::vector <Edge> &matching_edges) {
+	inline void ComputeMatching(std::vector <int> vertex_degree_list, const std::shared_ptr <const APSP> &apsp, std::vector <Edge> &matching_edges) {
 		size_t num_odd_vertices = std::count_if (vertex_degree_list.begin(), vertex_degree_list.end(), [](int i) {return ((i%2) == 1);});
 		std::vector <size_t> odd_vertices;
 		odd_vertices.reserve(num_odd_vertices);
@@ -34,19 +34,6 @@ namespace lclibrary {
 
 	bool MST_Prim(const std::shared_ptr <const Graph> &g, std::vector<Edge> &mst_edges) {
 		size_t n = g->GetN();
-		size_t m = g->GetM();
-		std::vector <std::vector <size_t>> adjacent_lists;
-		adjacent_lists.resize(n);
-
-		size_t t, h;
-		for(size_t i = 0; i < m; ++i) {
-			g->GetVerticesIndexOfEdge(i, t, h);
-			adjacent_lists[t].push_back(i);
-			adjacent_lists[h].push_back(i);
-		}
-
-		std::vector <size_t> adjacent_list_iterator;
-		adjacent_list_iterator.resize(n, 0);
 
 		std::vector <size_t> vertex_list(n, kNIL);
 		for(size_t i = 0; i < n; ++i) {
@@ -69,20 +56,16 @@ namespace lclibrary {
 			if(visited[u] == true)
 				continue;
 			visited[u] = true;
-			while(adjacent_list_iterator[u] < adjacent_lists[u].size()) {
+			for(const auto &e:g->GetIncidentEdges(u, kIsRequired)) {
 				size_t v;
 				size_t t, h;
-				auto e = adjacent_lists[u][adjacent_list_iterator[u]];
 				g->GetVerticesIndexOfEdge(e, t, h);
-				++adjacent_list_iterator[u];
 				if(u == t)
 					v = h;
 				else
 					v = t;
 
 				if(visited[v] == false and g->GetCost(e) < value[v] ) {
-
-					g->GetVerticesIndexOfEdge(e, t, h);
 					mst_edges.push_back(*(g->GetEdge(e)));
 					value[v] = g->GetCost(e);
 					q.push(v);
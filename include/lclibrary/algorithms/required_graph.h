@@ -26,6 +26,7 @@
 
 #include <lclibrary/core/vertex.h>
 #include <lclibrary/core/graph.h>
+#include <lclibrary/core/graph_builder.h>
 #include <lclibrary/algorithms/connected_components.h>
 #include <memory>
 
@@ -58,8 +59,8 @@ namespace lclibrary {
 			g->GetEdgeData(i, e, kIsRequired);
 			edge_list.push_back(e);
 		}
-		g_r = std::make_shared <Graph> (vertex_list, edge_list, m, 0);
-		return 0;
+		GraphBuilder graph_builder(std::move(vertex_list), std::move(edge_list));
+		return graph_builder.Build(g_r);
 	}
 
 	inline size_t GetNumCCRequiredGraph(std::shared_ptr <const Graph> g) {
@@ -23,6 +23,8 @@
 #define LCLIBRARY_CORE_CONFIG_H_
 
 #include <lclibrary/core/constants.h>
+#include <lclibrary/algorithms/apsp_base.h>
+#include <lclibrary/utils/fingerprint.h>
 #include <yaml-cpp/yaml.h>
 
 #include <string>
@@ -52,6 +54,8 @@ namespace lclibrary {
 				std::string nodes_data;
 				std::string req_edges;
 				std::string nonreq_edges;
+				std::string graph_binary; /* Graph in the binary format, see WriteGraphBinary(); empty reads the text files */
+				std::string edge_shapes = "edge_shapes"; /* Shape points of the required edges, see simplify_chains */
 			} filenames;
 
 			struct InputGraph {
@@ -61,6 +65,7 @@ namespace lclibrary {
 
 			bool convert_osm_graph = false;
 			bool add_pairwise_nonreq_edges = false;
+			bool simplify_chains = false; /* Contract the shape vertices of the OSM ways when converting them, see ContractShapeVertices() */
 
 			struct PlotInGraph {
 				bool plot = false;
@@ -81,6 +86,7 @@ namespace lclibrary {
 			std::string solver_mlc_md;
 
 			bool use_2opt;
+			APSP_Options apsp;
 			double ilp_time_limit;
 			double capacity;
 			bool cap_arg = false;
@@ -242,9 +248,18 @@ namespace lclibrary {
 				filenames.nodes_data = filenames_yaml["nodes_data"].as<std::string>();
 				filenames.req_edges = filenames_yaml["req_edges"].as<std::string>();
 				filenames.nonreq_edges = filenames_yaml["nonreq_edges"].as<std::string>();
+				if(filenames_yaml["graph_binary"]) {
+					filenames.graph_binary = filenames_yaml["graph_binary"].as<std::string>();
+				}
+				if(filenames_yaml["edge_shapes"]) {
+					filenames.edge_shapes = filenames_yaml["edge_shapes"].as<std::string>();
+				}
 
 				convert_osm_graph = yaml_config_["convert_osm_json"].as<bool>();
 				add_pairwise_nonreq_edges = yaml_config_["add_pairwise_nonreq_edges"].as<bool>();
+				if(yaml_config_["simplify_chains"]) {
+					simplify_chains = yaml_config_["simplify_chains"].as<bool>();
+				}
 
 				plot_input_graph.plot = yaml_config_["plot_input_graph"]["plot"].as<bool>();
 				plot_input_graph.plot_nreq_edges = yaml_config_["plot_input_graph"]["plot_nreq_edges"].as<bool>();
@@ -276,6 +291,47 @@ namespace lclibrary {
 				ilp_time_limit = yaml_config_["ilp_time_limit"].as<double>();
 				capacity = yaml_config_["capacity"].as<double>();
 
+				if(yaml_config_["apsp"]) {
+					auto apsp_yaml = yaml_config_["apsp"];
+					if(apsp_yaml["backend"]) {
+						std::string backend = apsp_yaml["backend"].as<std::string>();
+						if(backend == "auto") {
+							apsp.backend = APSP_Options::automatic;
+						} else if(backend == "floyd_warshall") {
+							apsp.backend = APSP_Options::floyd_warshall;
+						} else if(backend == "dijkstra") {
+							apsp.backend = APSP_Options::dijkstra;
+						} else if(backend == "lazy") {
+							apsp.backend = APSP_Options::lazy;
+						} else if(backend == "terminals") {
+							apsp.backend = APSP_Options::terminals;
+						} else if(backend == "contraction_hierarchy") {
+							apsp.backend = APSP_Options::contraction_hierarchy;
+						} else {
+							std::cerr << "Unknown APSP backend " << backend << std::endl;
+							return kFail;
+						}
+					}
+					if(apsp_yaml["num_threads"]) {
+						apsp.num_threads = apsp_yaml["num_threads"].as<size_t>();
+					}
+					if(apsp_yaml["cache_memory_mb"]) {
+						apsp.cache_memory_mb = apsp_yaml["cache_memory_mb"].as<size_t>();
+					}
+					if(apsp_yaml["single_precision"]) {
+						apsp.single_precision = apsp_yaml["single_precision"].as<bool>();
+					}
+					if(apsp_yaml["lazy_demand"]) {
+						apsp.lazy_demand = apsp_yaml["lazy_demand"].as<bool>();
+					}
+					if(apsp_yaml["cache"] and apsp_yaml["cache"].as<bool>()) {
+						apsp.cache_dir = database.dir + "apsp_cache/";
+						if(apsp_yaml["cache_dir"]) {
+							apsp.cache_dir = apsp_yaml["cache_dir"].as<std::string>();
+						}
+					}
+				}
+
 				cost_function = yaml_config_["cost_function"].as<std::string>();
 				if(cost_function == "travel_time") {
 					auto travel_time_yaml = yaml_config_["travel_time_config"];
@@ -296,6 +352,25 @@ namespace lclibrary {
 					travel_time_circ_turns.delta = travel_time_yaml["delta"].as<double>();
 				}
 
+				Fingerprint cost_fingerprint;
+				cost_fingerprint.Add(cost_function);
+				if(cost_function == "travel_time") {
+					cost_fingerprint.Add(travel_time.service_speed);
+					cost_fingerprint.Add(travel_time.deadhead_speed);
+					cost_fingerprint.Add(travel_time.wind_speed);
+					cost_fingerprint.Add(travel_time.wind_dir);
+				}
+				if(cost_function == "travel_time_circturns") {
+					cost_fingerprint.Add(travel_time_circ_turns.service_speed);
+					cost_fingerprint.Add(travel_time_circ_turns.deadhead_speed);
+					cost_fingerprint.Add(travel_time_circ_turns.wind_speed);
+					cost_fingerprint.Add(travel_time_circ_turns.wind_dir);
+					cost_fingerprint.Add(travel_time_circ_turns.acc);
+					cost_fingerprint.Add(travel_time_circ_turns.angular_vel);
+					cost_fingerprint.Add(travel_time_circ_turns.delta);
+				}
+				apsp.cost_fingerprint = cost_fingerprint.Get();
+
 				auto route_output_yaml = yaml_config_["route_output"];
 				route_output.plot = route_output_yaml["plot"].as<bool>();
 				route_output.kml = route_output_yaml["kml"].as<bool>();
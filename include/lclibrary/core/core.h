@@ -31,6 +31,7 @@
 #include <lclibrary/core/edge.h>
 #include <lclibrary/core/edge_cost_base.h>
 #include <lclibrary/core/graph.h>
+#include <lclibrary/core/graph_builder.h>
 #include <lclibrary/core/graph_io.h>
 #include <lclibrary/core/graph_utilities.h>
 #include <lclibrary/core/route.h>
@@ -31,7 +31,9 @@
 #include <lclibrary/core/vertex.h>
 #include <lclibrary/core/vec2d.h>
 #include <algorithm>
+#include <memory>
 #include <tuple>
+#include <vector>
 
 namespace lclibrary {
 
@@ -40,12 +42,17 @@ namespace lclibrary {
 		return std::make_tuple(e, is_rev);
 	}
 
+	/*! Vertices that only give the shape of an edge between its tail and head, see ContractShapeVertices() */
+	typedef std::vector <Vertex> EdgeShape;
+
 	class Edge {
 
 		private:
 			const Vertex *tail_vertex_ = nullptr; /*! tail Vertex */
 			const Vertex *head_vertex_ = nullptr; /*! head Vertex */
 			size_t tail_vertex_ID_ = kNIL, head_vertex_ID_ = kNIL;
+			/*! Indices of the vertices in the graph that last resolved the edge, see Graph::GetTailVertexIndex(); kNIL if unknown */
+			size_t tail_vertex_index_ = kNIL, head_vertex_index_ = kNIL;
 			bool is_required_ = kIsRequired;
 			double cost_ = 0;
 			double service_cost_ = 0; /*! service cost of Edge */
@@ -59,6 +66,10 @@ namespace lclibrary {
 			double deadhead_demand_ = 0;
 			double deadhead_demand_rev_ = 0;
 
+			/*! Shape points ordered from the tail to the head of the edge as it was contracted; shared by the copies of the edge */
+			std::shared_ptr <const EdgeShape> shape_ = nullptr;
+			bool is_shape_reversed_ = false;
+
 		public:
 
 			/*! Constructors */
@@ -79,6 +90,7 @@ namespace lclibrary {
 			void SetVertices(const Vertex *t, const Vertex *h) {
 				tail_vertex_ = t; head_vertex_ = h;
 				tail_vertex_ID_ = kNIL; head_vertex_ID_ = kNIL;
+				tail_vertex_index_ = kNIL; head_vertex_index_ = kNIL;
 				if(tail_vertex_ != nullptr)
 					tail_vertex_ID_ = tail_vertex_->GetID();
 				if(head_vertex_ != nullptr)
@@ -139,6 +151,10 @@ namespace lclibrary {
 			inline size_t GetTailVertexID () const {return tail_vertex_ID_;}
 			inline size_t GetHeadVertexID () const {return head_vertex_ID_;}
 
+			inline void SetVertexIndices(const size_t t, const size_t h) { tail_vertex_index_ = t; head_vertex_index_ = h; }
+			inline size_t GetTailVertexIndexHint() const { return tail_vertex_index_; }
+			inline size_t GetHeadVertexIndexHint() const { return head_vertex_index_; }
+
 			inline void SetCosts(const double c){ cost_ = c; service_cost_ = c; service_cost_rev_ = c; deadhead_cost_ = c; deadhead_cost_rev_ = c; }
 			inline void SetServiceCost(const double c){ service_cost_ = c; service_cost_rev_ = c; }
 			inline void SetServiceCost(const double c, const double crev){ service_cost_ = c; service_cost_rev_ = crev; }
@@ -175,12 +191,72 @@ namespace lclibrary {
 				deadhead_demand_rev_ = deadhead_cost_rev_;
 			}
 
+			inline void SetShape(const std::shared_ptr <const EdgeShape> &shape) {
+				shape_ = (shape == nullptr or shape->empty()) ? nullptr : shape;
+				is_shape_reversed_ = false;
+			}
+
+			inline bool HasShape() const { return shape_ != nullptr; }
+			inline size_t GetNumShapePoints() const { return shape_ == nullptr ? 0 : shape_->size(); }
+
+			/*! The polyline of the edge is the tail, the shape points and the head; an edge without shape is a single segment */
+			inline size_t GetNumPolylinePoints() const { return GetNumShapePoints() + 2; }
+
+			/*! Point k of the polyline, counted from the tail */
+			inline const Vertex & GetPolylinePoint(const size_t k) const {
+				const size_t num_shape_points = GetNumShapePoints();
+				if(k == 0) {
+					return *tail_vertex_;
+				}
+				if(k > num_shape_points) {
+					return *head_vertex_;
+				}
+				return is_shape_reversed_ ? (*shape_)[num_shape_points - k] : (*shape_)[k - 1];
+			}
+
+			/*! First segment of the polyline in the direction of travel; from the head if is_rev */
+			void GetFirstSegmentXY(Vec2d &from_xy, Vec2d &to_xy, const bool is_rev = false) const {
+				const size_t last = GetNumPolylinePoints() - 1;
+				from_xy = GetPolylinePoint(is_rev ? last : 0).GetXY();
+				to_xy = GetPolylinePoint(is_rev ? last - 1 : 1).GetXY();
+			}
+
+			/*! Last segment of the polyline in the direction of travel; towards the tail if is_rev */
+			void GetLastSegmentXY(Vec2d &from_xy, Vec2d &to_xy, const bool is_rev = false) const {
+				const size_t last = GetNumPolylinePoints() - 1;
+				from_xy = GetPolylinePoint(is_rev ? 1 : last - 1).GetXY();
+				to_xy = GetPolylinePoint(is_rev ? 0 : last).GetXY();
+			}
+
+			/*! Length of the polyline */
+			double GetLength() const {
+				double length = 0;
+				for(size_t k = 1; k < GetNumPolylinePoints(); ++k) {
+					length += GetPolylinePoint(k - 1).GetXY().Dist(GetPolylinePoint(k).GetXY());
+				}
+				return length;
+			}
+
+			/*! Moves the shape points with the vertices, see Graph::ShiftOrigin(). The shape is copied, so that copies of the edge keep theirs. */
+			void ShiftShape(const double dx, const double dy) {
+				if(shape_ == nullptr) {
+					return;
+				}
+				auto shape = std::make_shared <EdgeShape>();
+				shape->reserve(shape_->size());
+				for(size_t k = 1; k <= shape_->size(); ++k) {
+					Vertex v = GetPolylinePoint(k);
+					auto xy = v.GetXY();
+					v.SetXY(xy.x - dx, xy.y - dy);
+					shape->push_back(v);
+				}
+				SetShape(shape);
+			}
+
 			/* Computes and sets service and deadhead costs to be the Euclidean costs
 			 * Costs are symmetric nad same for service and deahead */
 			void ComputeCost() {
-				auto t_xy = tail_vertex_->GetXY();
-				auto h_xy = head_vertex_->GetXY();
-				auto dist = t_xy.Dist(h_xy);
+				auto dist = GetLength();
 				SetServiceCost(dist, dist);
 				SetDeadheadCost(dist, dist);
 				cost_ = dist;
@@ -190,9 +266,7 @@ namespace lclibrary {
 			 * Requires accelearation and velocity
 			 * Costs are symmetric and same for service and deadhead */
 			void ComputeTravelTimeRamp(const double acc, const double vel) {
-				auto t_xy = tail_vertex_->GetXY();
-				auto h_xy = head_vertex_->GetXY();
-				auto dist = t_xy.Dist(h_xy);
+				auto dist = GetLength();
 				double t_ramp = vel/acc;
 				double dist_ramp = vel * t_ramp / 2.0;
 				double total_time;
@@ -212,8 +286,10 @@ namespace lclibrary {
 				std::swap(service_cost_, service_cost_rev_);
 				std::swap(deadhead_cost_, deadhead_cost_rev_);
 				std::swap(tail_vertex_ID_, head_vertex_ID_);
+				std::swap(tail_vertex_index_, head_vertex_index_);
 				std::swap(service_demand_, service_demand_rev_);
 				std::swap(deadhead_demand_, deadhead_demand_rev_);
+				is_shape_reversed_ = not is_shape_reversed_;
 			}
 
 	};
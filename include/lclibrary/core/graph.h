@@ -1,6 +1,6 @@
 /**
  * This file is part of the LineCoverage-library.
- * The file contains the description of the class Graph
+ * The file contains the description of the class template BasicGraph and of Graph, its instantiation with Vertex and Edge
  *
  * @author Saurav Agarwal
  * @contact sagarw10@uncc.edu
@@ -19,10 +19,6 @@
  * You should have received a copy of the GNU General Public License along with LineCoverage-library. If not, see <https://www.gnu.org/licenses/>.
  */
 
-/**
- * TODO: Make the class templated and header only so that other vertex and edge objects can be used
- */
-
 #ifndef LCLIBRARY_CORE_GRAPH_H_
 #define LCLIBRARY_CORE_GRAPH_H_
 
@@ -32,6 +28,8 @@
 #include <lclibrary/core/edge.h>
 #include <lclibrary/core/edge_cost_base.h>
 #include <lclibrary/utils/edge_cost_with_circular_turns.h>
+#include <lclibrary/utils/object_arena.h>
+#include <lclibrary/utils/memory_footprint.h>
 
 #include <vector>
 #include <array>
@@ -39,6 +37,8 @@
 #include <cfloat>
 #include <fstream>
 #include <memory>
+#include <algorithm>
+#include <iostream>
 
 namespace lclibrary {
 
@@ -52,18 +52,129 @@ namespace lclibrary {
 
 	typedef std::vector <GraphEdge> GraphEdgeList;
 
-	class Graph
+	/*! Structure of arrays copy of the vertices, so that scans over one field touch only that field */
+	struct VertexStore {
+		std::vector <size_t> id_;
+		std::vector <double> x_;
+		std::vector <double> y_;
+		std::vector <std::array <double, 3>> lla_;
+
+		void Resize(const size_t n) {
+			id_.resize(n); x_.resize(n); y_.resize(n); lla_.resize(n);
+		}
+
+		void Set(const size_t v, const Vertex &vertex) {
+			id_[v] = vertex.GetID();
+			auto xy = vertex.GetXY();
+			x_[v] = xy.x; y_[v] = xy.y;
+			vertex.GetLLA(lla_[v].data());
+		}
+
+		inline void GetLLA(const size_t v, double *lla) const {
+			for(size_t i = 0; i < 3; ++i) {
+				lla[i] = lla_[v][i];
+			}
+		}
+
+		size_t MemoryFootprint() const {
+			return VectorBytes(id_) + VectorBytes(x_) + VectorBytes(y_) + VectorBytes(lla_);
+		}
+	};
+
+	/*! Structure of arrays copy of the required or of the non-required edges. Index 0 of the arrays of pairs holds the forward, index 1 the reverse direction. */
+	struct EdgeStore {
+		std::vector <size_t> tail_;
+		std::vector <size_t> head_;
+		std::vector <double> cost_;
+		std::vector <double> demand_;
+		std::array <std::vector <double>, 2> service_cost_;
+		std::array <std::vector <double>, 2> deadhead_cost_;
+		std::array <std::vector <double>, 2> service_demand_;
+		std::array <std::vector <double>, 2> deadhead_demand_;
+
+		void Resize(const size_t m) {
+			tail_.resize(m); head_.resize(m); cost_.resize(m); demand_.resize(m);
+			for(size_t k = 0; k < 2; ++k) {
+				service_cost_[k].resize(m); deadhead_cost_[k].resize(m);
+				service_demand_[k].resize(m); deadhead_demand_[k].resize(m);
+			}
+		}
+
+		/*! Copies the costs and demands; tail_ and head_ are set by BasicGraph::AdjacencyListGeneration() */
+		void Set(const size_t i, const Edge &e) {
+			cost_[i] = e.GetCost();
+			demand_[i] = e.GetDemand();
+			service_cost_[0][i] = e.GetServiceCost(); service_cost_[1][i] = e.GetReverseServiceCost();
+			deadhead_cost_[0][i] = e.GetDeadheadCost(); deadhead_cost_[1][i] = e.GetReverseDeadheadCost();
+			service_demand_[0][i] = e.GetServiceDemand(); service_demand_[1][i] = e.GetReverseServiceDemand();
+			deadhead_demand_[0][i] = e.GetDeadheadDemand(); deadhead_demand_[1][i] = e.GetReverseDeadheadDemand();
+		}
+
+		inline double Cost(const size_t i) const { return cost_[i]; }
+		inline double Demand(const size_t i) const { return demand_[i]; }
+		inline double ServiceCost(const size_t i, const bool is_rev) const { return service_cost_[is_rev][i]; }
+		inline double DeadheadCost(const size_t i, const bool is_rev) const { return deadhead_cost_[is_rev][i]; }
+		inline double ServiceDemand(const size_t i, const bool is_rev) const { return service_demand_[is_rev][i]; }
+		inline double DeadheadDemand(const size_t i, const bool is_rev) const { return deadhead_demand_[is_rev][i]; }
+
+		size_t MemoryFootprint() const {
+			size_t bytes = VectorBytes(tail_) + VectorBytes(head_) + VectorBytes(cost_) + VectorBytes(demand_);
+			for(size_t k = 0; k < 2; ++k) {
+				bytes += VectorBytes(service_cost_[k]) + VectorBytes(deadhead_cost_[k]) + VectorBytes(service_demand_[k]) + VectorBytes(deadhead_demand_[k]);
+			}
+			return bytes;
+		}
+	};
+
+	/*! Structure of arrays copies used by BasicGraph for a vertex or edge type. Specialize them together with the vertex and edge types. */
+	template <typename VertexT>
+		struct VertexStoreOf { typedef VertexStore type; };
+
+	template <typename EdgeT>
+		struct EdgeStoreOf { typedef EdgeStore type; };
+
+	/*! Read-only view of a contiguous range of edge indices */
+	class IndexSpan {
+		const size_t *begin_;
+		const size_t *end_;
+
+		public:
+		IndexSpan(const size_t *begin, const size_t *end) : begin_{begin}, end_{end} {}
+		inline const size_t * begin() const { return begin_; }
+		inline const size_t * end() const { return end_; }
+		inline size_t size() const { return end_ - begin_; }
+		inline bool empty() const { return begin_ == end_; }
+		inline size_t operator [] (const size_t i) const { return begin_[i]; }
+	};
+
+	/*! Vertices of a graph. They are shared by a graph with its copies and subgraphs; a graph that changes its vertices first makes its own copy of them, see BasicGraph::UnshareVertices(). */
+	template <typename VertexT>
+		struct GraphVertices {
+			std::vector <VertexT *> vertex_list_; /*! Stores the vertices of the graph */
+			ObjectArena <VertexT> vertex_arena_; /*! Owns the vertices of vertex_list_ */
+			std::unordered_map <size_t, size_t> vertex_map_; /*! Stores a map of the index of vertices to actual ID of the node <ID, index>*/
+			typename VertexStoreOf <VertexT>::type vertex_store_;
+		};
+
+	/*! Graph of vertices of type VertexT and edges of type EdgeT.
+	 * VertexT provides GetID() and GetXY(); EdgeT provides the interface of Edge, with pointers to VertexT as vertices.
+	 * The turn costs (SetTurnsCostFunction()) are only available for EdgeT = Edge. */
+	template <typename VertexT, typename EdgeT>
+	class BasicGraph
 	{
 
+		public:
+			typedef VertexT VertexType;
+			typedef EdgeT EdgeType;
+
 		private:
+			typedef std::vector <EdgeT *> EdgeTList;
 
-			VertexList vertex_list_; /*! Stores the vertices of the graph */
-			EdgeList required_edge_list_; /*! Stores the required edges of the graph */
-			EdgeList non_required_edge_list_; /*! Stores the required edges of the graph */
+			std::shared_ptr <GraphVertices <VertexT>> vertices_ = std::make_shared <GraphVertices <VertexT>>();
+			EdgeTList required_edge_list_; /*! Stores the required edges of the graph */
+			EdgeTList non_required_edge_list_; /*! Stores the required edges of the graph */
 			std::vector <size_t> depot_list_;
 
-			std::unordered_map <size_t, size_t> vertex_map_; /*! Stores a map of the index of vertices to actual ID of the node <ID, index>*/
-
 			size_t n_ = 0; /*! No. of Vertices */
 			size_t m_ = 0; /*! No. of required Edges */
 			size_t m_nr_ = 0; /*! No. of non-required Edges */
@@ -74,25 +185,310 @@ namespace lclibrary {
 			double capacity_;
 			std::shared_ptr <EdgeCost_CircularTurns> edge_cost_fn_ = nullptr;
 
+			/*! Compressed sparse row adjacency built by AdjacencyListGeneration(), indexed by AdjacencySlot(). The edges with tail v are out_edges_[k][out_offsets_[k][v]] to out_edges_[k][out_offsets_[k][v + 1] - 1]. incident_edges_ lists every edge at its tail and at its head. */
+			std::array <std::vector <size_t>, 2> out_offsets_;
+			std::array <std::vector <size_t>, 2> out_edges_;
+			std::array <std::vector <size_t>, 2> incident_offsets_;
+			std::array <std::vector <size_t>, 2> incident_edges_;
+
+			static inline size_t AdjacencySlot(const bool is_req) { return is_req ? 0 : 1; }
+
+			ObjectArena <EdgeT> edge_arena_; /*! Owns the edges of both edge lists */
+			/*! The accessors of BasicGraph read edge data from these copies, and vertex data from vertices_->vertex_store_. Every change to a vertex or edge goes through BasicGraph, which updates its copy. */
+			std::array <typename EdgeStoreOf <EdgeT>::type, 2> edge_store_; /*! Indexed by AdjacencySlot() */
+
+			inline void StoreEdge(const size_t i, const bool is_req) {
+				edge_store_[AdjacencySlot(is_req)].Set(i, *GetEdge(i, is_req));
+			}
+
+			void StoreEdges() {
+				for(size_t i = 0; i < required_edge_list_.size(); ++i) {
+					StoreEdge(i, kIsRequired);
+				}
+				for(size_t i = 0; i < non_required_edge_list_.size(); ++i) {
+					StoreEdge(i, kIsNotRequired);
+				}
+			}
+
+			void StoreVertices() {
+				auto &vertices = *vertices_;
+				vertices.vertex_store_.Resize(vertices.vertex_list_.size());
+				for(size_t v = 0; v < vertices.vertex_list_.size(); ++v) {
+					vertices.vertex_store_.Set(v, *vertices.vertex_list_[v]);
+				}
+			}
+
+			/*! Copies the vertices if another graph shares them and points the edges to the copies */
+			GraphVertices <VertexT> & UnshareVertices() {
+				if(vertices_.use_count() == 1) {
+					return *vertices_;
+				}
+				auto shared_vertices = vertices_;
+				vertices_ = std::make_shared <GraphVertices <VertexT>>();
+				auto &vertices = *vertices_;
+				vertices.vertex_list_.reserve(shared_vertices->vertex_list_.size());
+				vertices.vertex_arena_.Reserve(shared_vertices->vertex_list_.size());
+				for(const auto &v:shared_vertices->vertex_list_) {
+					vertices.vertex_list_.push_back(vertices.vertex_arena_.Create(*v));
+				}
+				vertices.vertex_map_ = shared_vertices->vertex_map_;
+				vertices.vertex_store_ = shared_vertices->vertex_store_;
+				for(const EdgeTList *edge_list:{&required_edge_list_, &non_required_edge_list_}) {
+					for(auto &e:*edge_list) {
+						size_t t, h;
+						GetTailVertexIndex(*e, t);
+						GetHeadVertexIndex(*e, h);
+						e->SetVertices(vertices.vertex_list_[t], vertices.vertex_list_[h]);
+						e->SetVertexIndices(t, h);
+					}
+				}
+				return vertices;
+			}
+
+			/*! Prints the number of IDs and the first few of them */
+			static void PrintIDs(const char *message, const std::vector <size_t> &ids) {
+				const size_t kMaxPrinted = 10;
+				std::cerr << message << " (" << ids.size() << "):";
+				for(size_t i = 0; i < ids.size() and i < kMaxPrinted; ++i) {
+					std::cerr << " " << ids[i];
+				}
+				if(ids.size() > kMaxPrinted) {
+					std::cerr << " ...";
+				}
+				std::cerr << std::endl;
+			}
+
 		protected:
-			int GetVertex (size_t const, Vertex* &) const;
+			int GetVertex (size_t const ID, VertexT* &v) const {
+				size_t idx;
+				if(GetVertexIndex(ID, idx)) {
+					v = nullptr;
+					return kFail;
+				}
+				v = vertices_->vertex_list_[idx];
+				return kSuccess;
+			}
+
+			/*! Copies e to the arena and points it to the vertices of this graph */
+			EdgeT * CopyEdge(const EdgeT &e) {
+				size_t t, h;
+				if(GetTailVertexIndex(e, t) or GetHeadVertexIndex(e, h)) {
+					return nullptr;
+				}
+				EdgeT *new_edge = edge_arena_.Create(e);
+				new_edge->SetVertices(vertices_->vertex_list_[t], vertices_->vertex_list_[h]);
+				new_edge->SetVertexIndices(t, h);
+				return new_edge;
+			}
 
 			void UpdateEdgeCounts(){
 				m_ = required_edge_list_.size();
 				m_nr_ = non_required_edge_list_.size();
 			}
 
-			int AdjacencyListGeneration();
+			/*! Resolves the vertex indices of the edges and stores them in the edges, copies the edges to the edge store and builds the compressed sparse row adjacency with a counting sort of the edges by vertex; the edges of a vertex keep the order of the edge list */
+			int AdjacencyListGeneration() {
+				const size_t n = vertices_->vertex_list_.size();
+				for(bool req:{kIsRequired, kIsNotRequired}) {
+					const EdgeTList &edge_list = req ? required_edge_list_ : non_required_edge_list_;
+					const size_t k = AdjacencySlot(req);
+					auto &out_offsets = out_offsets_[k];
+					auto &out_edges = out_edges_[k];
+					auto &incident_offsets = incident_offsets_[k];
+					auto &incident_edges = incident_edges_[k];
+					out_offsets.assign(n + 1, 0);
+					incident_offsets.assign(n + 1, 0);
+					out_edges.clear();
+					incident_edges.clear();
+
+					auto &store = edge_store_[k];
+					store.Resize(edge_list.size());
+					std::vector <size_t> &tails = store.tail_, &heads = store.head_;
+					std::fill(tails.begin(), tails.end(), kNIL);
+					std::fill(heads.begin(), heads.end(), kNIL);
+					for(size_t i = 0; i < edge_list.size(); ++i) {
+						store.Set(i, *edge_list[i]);
+					}
+					for(size_t i = 0; i < edge_list.size(); ++i) {
+						/* Edges resolved by an earlier call keep valid indices, as vertices are only appended; edges copied from another graph are looked up */
+						if(GetTailVertexIndex(*edge_list[i], tails[i]) or GetHeadVertexIndex(*edge_list[i], heads[i])) {
+							std::cerr << "Edge list error" << std::endl;
+							out_offsets.assign(n + 1, 0);
+							incident_offsets.assign(n + 1, 0);
+							return kFail;
+						}
+						edge_list[i]->SetVertexIndices(tails[i], heads[i]);
+						++out_offsets[tails[i] + 1];
+						++incident_offsets[tails[i] + 1];
+						++incident_offsets[heads[i] + 1];
+					}
+					for(size_t v = 0; v < n; ++v) {
+						out_offsets[v + 1] += out_offsets[v];
+						incident_offsets[v + 1] += incident_offsets[v];
+					}
+
+					out_edges.resize(edge_list.size());
+					incident_edges.resize(2 * edge_list.size());
+					std::vector <size_t> out_next(out_offsets.begin(), out_offsets.end() - 1);
+					std::vector <size_t> incident_next(incident_offsets.begin(), incident_offsets.end() - 1);
+					for(size_t i = 0; i < edge_list.size(); ++i) {
+						out_edges[out_next[tails[i]]++] = i;
+						incident_edges[incident_next[tails[i]]++] = i;
+						incident_edges[incident_next[heads[i]]++] = i;
+					}
+				}
+				return kSuccess;
+			}
 
 		public:
 
-			Graph() : n_{0}, m_{0}, m_nr_{0} {}
-			Graph (const std::vector <Vertex> &, const std::vector <Edge> &, const size_t m_i = 0, const size_t m_nr_i = 0);
-			Graph(const Graph &g){ CopyDataFromGraph(g); }
-			inline void operator = (const Graph &g ) { CopyDataFromGraph(g); }
-			bool CopyDataFromGraph(const Graph &g);
+			BasicGraph() : n_{0}, m_{0}, m_nr_{0} {}
 
-			~Graph();
+			/*! The number of required and non-required edges need not be given; they are counted by AssembleGraph() */
+			BasicGraph (const std::vector <VertexT> &vertex_list_i, const std::vector <EdgeT> &edge_list_i, const size_t = 0, const size_t = 0) {
+				if(AssembleGraph(vertex_list_i, edge_list_i)) {
+					std::cerr << "Graph generation failed: edge list error" << std::endl;
+				}
+			}
+
+			/*! Replaces the vertices and edges of the graph. The vertex IDs are hashed once, and the edges are resolved against that table.
+			 * Repeated vertex IDs are reported together and ignored. Edges with unknown vertex IDs are reported together, and the graph is then left unchanged and kFail returned. */
+			int AssembleGraph(const std::vector <VertexT> &vertex_list_i, const std::vector <EdgeT> &edge_list_i) {
+				auto new_vertices = std::make_shared <GraphVertices <VertexT>>();
+				auto &vertices = *new_vertices;
+				const size_t n_i = vertex_list_i.size();
+				vertices.vertex_list_.reserve(n_i);
+				vertices.vertex_arena_.Reserve(n_i);
+				vertices.vertex_map_.reserve(n_i);
+				std::vector <size_t> repeated_ids;
+				for(const auto &v:vertex_list_i) {
+					if(vertices.vertex_map_.emplace(v.GetID(), vertices.vertex_list_.size()).second == false) {
+						repeated_ids.push_back(v.GetID());
+						continue;
+					}
+					vertices.vertex_list_.push_back(vertices.vertex_arena_.Create(v));
+				}
+				if(not repeated_ids.empty()) {
+					PrintIDs("Repeated vertices ignored", repeated_ids);
+				}
+
+				const size_t n = vertices.vertex_list_.size();
+				auto resolve = [&](const size_t ID, const size_t hint, size_t &idx) {
+					if(hint < n and vertices.vertex_list_[hint]->GetID() == ID) {
+						idx = hint;
+						return kSuccess;
+					}
+					auto search_vertex = vertices.vertex_map_.find(ID);
+					if(search_vertex == vertices.vertex_map_.end()) {
+						return kFail;
+					}
+					idx = search_vertex->second;
+					return kSuccess;
+				};
+				std::vector <size_t> tails(edge_list_i.size()), heads(edge_list_i.size());
+				std::vector <size_t> dangling_ids;
+				size_t m_req = 0;
+				for(size_t i = 0; i < edge_list_i.size(); ++i) {
+					const EdgeT &e = edge_list_i[i];
+					if(resolve(e.GetTailVertexID(), e.GetTailVertexIndexHint(), tails[i])) {
+						dangling_ids.push_back(e.GetTailVertexID());
+					}
+					if(resolve(e.GetHeadVertexID(), e.GetHeadVertexIndexHint(), heads[i])) {
+						dangling_ids.push_back(e.GetHeadVertexID());
+					}
+					if(e.GetReq()) {
+						++m_req;
+					}
+				}
+				if(not dangling_ids.empty()) {
+					PrintIDs("Edges with vertices not in the graph", dangling_ids);
+					return kFail;
+				}
+
+				vertices_ = new_vertices;
+				n_ = n;
+				StoreVertices();
+				required_edge_list_.clear();
+				non_required_edge_list_.clear();
+				edge_arena_.Clear();
+				required_edge_list_.reserve(m_req);
+				non_required_edge_list_.reserve(edge_list_i.size() - m_req);
+				edge_arena_.Reserve(edge_list_i.size());
+				for(size_t i = 0; i < edge_list_i.size(); ++i) {
+					EdgeT *new_edge = edge_arena_.Create(edge_list_i[i]);
+					new_edge->SetVertices(vertices.vertex_list_[tails[i]], vertices.vertex_list_[heads[i]]);
+					new_edge->SetVertexIndices(tails[i], heads[i]);
+					if(new_edge->GetReq()) {
+						required_edge_list_.push_back(new_edge);
+					}
+					else {
+						non_required_edge_list_.push_back(new_edge);
+					}
+				}
+				UpdateEdgeCounts();
+				return AdjacencyListGeneration();
+			}
+
+			/*! Subgraph of g with the given edges, e.g. a route. The subgraph shares the vertices of g, so only its edges are copied. */
+			BasicGraph (const BasicGraph &g, const std::vector <EdgeT> &edge_list_i) : vertices_{g.vertices_} {
+				n_ = vertices_->vertex_list_.size();
+				if(AddEdge(edge_list_i)) {
+					std::cerr << "Graph generation failed: edge list error" << std::endl;
+				}
+			}
+
+			BasicGraph(const BasicGraph &g){ CopyDataFromGraph(g); }
+			inline void operator = (const BasicGraph &g ) { CopyDataFromGraph(g); }
+
+			bool CopyDataFromGraph(const BasicGraph &g) {
+				n_ = g.GetN();
+				vertices_ = g.vertices_;
+				m_ = g.GetM();
+				required_edge_list_.clear();
+				required_edge_list_.reserve(m_);
+				m_nr_ = g.GetMnr();
+				non_required_edge_list_.clear();
+				non_required_edge_list_.reserve(m_nr_);
+				edge_arena_.Clear();
+				edge_arena_.Reserve(m_ + m_nr_);
+
+				for (size_t i = 0; i < m_; ++i) {
+					auto e = *(g.GetEdge(i, kIsRequired));
+					EdgeT *new_edge = CopyEdge(e);
+					if(new_edge == nullptr) {
+						std::cerr << "Edge list error" << std::endl;
+						return 1;
+					}
+					required_edge_list_.push_back(new_edge);
+				}
+				for (size_t i = 0; i < m_nr_; ++i) {
+					auto e = *(g.GetEdge(i, kIsNotRequired));
+					EdgeT *new_edge = CopyEdge(e);
+					if(new_edge == nullptr) {
+						std::cerr << "Edge list error" << std::endl;
+						return kFail;
+					}
+					non_required_edge_list_.push_back(new_edge);
+				}
+				UpdateEdgeCounts();
+				AdjacencyListGeneration();
+				capacity_ = g.GetCapacity();
+				if(g.IsDepotSet()) {
+					depot_ = g.GetDepot();
+					is_depot_set_ = true;
+					GetVertexXY(depot_, depot_xy_);
+				}
+				if(g.IsMultipleDepotSet()) {
+					std::vector <size_t> depots;
+					g.GetDepotsIDs(depots);
+					AddDepots(depots);
+				}
+
+				return kSuccess;
+			}
+
+			/*! The edges are destroyed with their arena, and the vertices with the last graph that shares them */
+			~BasicGraph() {}
 
 			void SetTurnsCostFunction(const std::shared_ptr <EdgeCost_CircularTurns> &cost_fn) {
 				edge_cost_fn_ = cost_fn;
@@ -123,20 +519,30 @@ namespace lclibrary {
 
 			bool SetDepotIndex(const size_t vertex_idx) {
 				depot_ = vertex_idx;
-				depot_id_ = vertex_list_[depot_]->GetID();
+				depot_id_ = GetVertexID(depot_);
 				is_depot_set_ = true;
 				GetVertexXY(depot_, depot_xy_);
 				return kSuccess;
 			}
 
-			int SetMeanDepot() {
+			/*! The endpoint of a required edge nearest to the mean of the vertices. The shape points of the edges count as vertices, so the mean does not change when shape vertices are contracted, see ContractShapeVertices(). */
+			size_t GetMeanDepotID() const {
 				Vec2d mean;
 				for(size_t i = 0; i < n_; ++i) {
 					Vec2d v_xy;
 					GetVertexXY(i, v_xy);
 					mean.Add(v_xy);
 				}
-				mean.x = mean.x/n_; mean.y = mean.y/n_;
+				size_t num_points = n_;
+				for(const auto *edge_list:{&required_edge_list_, &non_required_edge_list_}) {
+					for(const auto &e:*edge_list) {
+						for(size_t k = 1; k <= e->GetNumShapePoints(); ++k) {
+							mean.Add(e->GetPolylinePoint(k).GetXY());
+						}
+						num_points += e->GetNumShapePoints();
+					}
+				}
+				mean.x = mean.x/num_points; mean.y = mean.y/num_points;
 				double min_dist_sqr = kDoubleMax;
 				size_t depot_id = GetVertexID(0);
 				for(size_t i = 0; i < m_; ++i) {
@@ -153,8 +559,11 @@ namespace lclibrary {
 						min_dist_sqr = mean.DistSqr(v_xy);
 					}
 				}
-				is_depot_set_ = true;
-				return SetDepot(depot_id);
+				return depot_id;
+			}
+
+			int SetMeanDepot() {
+				return SetDepot(GetMeanDepotID());
 			}
 
 			size_t GetDepot() const {
@@ -220,7 +629,7 @@ namespace lclibrary {
 
 			void AddAllDepots() {
 				depot_list_.clear();
-				for(auto &v:vertex_list_) {
+				for(auto &v:vertices_->vertex_list_) {
 					depot_list_.push_back(v->GetID());
 				}
 			}
@@ -258,47 +667,121 @@ namespace lclibrary {
 
 			/* ************************* */
 			/* Vertex related functions */
-			inline const Vertex * GetVertex(size_t i) const {
+			inline const VertexT * GetVertex(size_t i) const {
 				if (i >= n_)
 					return nullptr;
-				return vertex_list_[i];
+				return vertices_->vertex_list_[i];
+			}
+
+			int GetVertexIndex (const size_t ID, size_t &idx) const {
+				auto search_vertex = vertices_->vertex_map_.find(ID);
+				if(search_vertex == vertices_->vertex_map_.end()){
+					std::cerr<<"Couldn't find vertex corresponding to ID\n";
+					std::cerr<< ID <<"\n";
+					idx = kNIL;
+					return kFail;
+				}
+				idx = search_vertex->second;
+				return kSuccess;
 			}
 
-			int GetVertexIndex (const size_t , size_t &) const;
 			inline size_t GetVertexID (const size_t v) const {
-				return vertex_list_[v]->GetID();
+				return vertices_->vertex_store_.id_[v];
 			}
-			inline void GetVertexData (const size_t i, Vertex &v) const {
-				v = *vertex_list_[i];
+			inline void GetVertexData (const size_t i, VertexT &v) const {
+				v = *vertices_->vertex_list_[i];
 			}
 
 			bool IsVertexInGraph (const size_t ID) const {
-				auto search_vertex = vertex_map_.find(ID);
-				if(search_vertex == vertex_map_.end())
+				auto search_vertex = vertices_->vertex_map_.find(ID);
+				if(search_vertex == vertices_->vertex_map_.end())
 					return kFail;
 				else
 					return kSuccess;
 			}
 
-			void AddVertex(Vertex *);
-			const Vertex* AddNewVertex(const Vertex &);
+			/*! Adds given Vertex; the graph takes ownership and keeps a copy in its arena */
+			void AddVertex(VertexT *v) {
+				AddNewVertex(*v);
+				delete v;
+			}
+
+			/*! Adds new Vertex by first creating a copy */
+			const VertexT* AddNewVertex(const VertexT &v) {
+				auto &vertices = UnshareVertices();
+				VertexT *new_vertex = vertices.vertex_arena_.Create(v);
+				vertices.vertex_list_.push_back(new_vertex);
+				n_ = vertices.vertex_list_.size();
+				vertices.vertex_map_[new_vertex->GetID()] = n_ - 1;
+				vertices.vertex_store_.Resize(n_);
+				vertices.vertex_store_.Set(n_ - 1, *new_vertex);
+				/* The new vertex has no edges yet */
+				for(auto *offsets:{&out_offsets_[0], &out_offsets_[1], &incident_offsets_[0], &incident_offsets_[1]}) {
+					if(offsets->empty()) {
+						offsets->push_back(0);
+					}
+					offsets->resize(n_ + 1, offsets->back());
+				}
+				return new_vertex;
+			}
 
 			inline void GetVertexXY(const size_t v, Vec2d &xy) const {
-				xy = vertex_list_[v]->GetXY();
+				xy = Vec2d(vertices_->vertex_store_.x_[v], vertices_->vertex_store_.y_[v]);
 			}
 
 			inline void GetVertexLLA(const size_t v, double * lla) const {
-				vertex_list_[v]->GetLLA(lla);
+				vertices_->vertex_store_.GetLLA(v, lla);
 			}
-			int GetVerticesIndexOfEdge(const size_t, size_t &, size_t &, const bool is_req = kIsRequired) const ;
-			void GetVerticesIDOfEdge(const size_t, size_t &, size_t &, const bool is_req = kIsRequired) const ;
+
+			/*! Get index of vertices of Edge e */
+			int GetVerticesIndexOfEdge(const size_t i, size_t &tIdx, size_t &hIdx, const bool is_req = kIsRequired) const {
+				const auto &store = edge_store_[AdjacencySlot(is_req)];
+				tIdx = store.tail_[i];
+				hIdx = store.head_[i];
+				if(tIdx == kNIL or hIdx == kNIL)
+					return kFail;
+				return kSuccess;
+			}
+
+			/*! Index of the vertex with the given ID. hint is tried first and used if it is the index of that vertex, otherwise the ID is looked up. */
+			inline int GetVertexIndex(const size_t ID, const size_t hint, size_t &idx) const {
+				if(hint < n_ and vertices_->vertex_store_.id_[hint] == ID) {
+					idx = hint;
+					return kSuccess;
+				}
+				return GetVertexIndex(ID, idx);
+			}
+
+			/*! Index of the tail vertex of an edge of this or of another graph, e.g. an edge of a route. The index stored in the edge is used if it is valid for this graph, so edges of this graph and their copies need no lookup. */
+			inline int GetTailVertexIndex(const EdgeT &e, size_t &idx) const {
+				return GetVertexIndex(e.GetTailVertexID(), e.GetTailVertexIndexHint(), idx);
+			}
+
+			inline int GetHeadVertexIndex(const EdgeT &e, size_t &idx) const {
+				return GetVertexIndex(e.GetHeadVertexID(), e.GetHeadVertexIndexHint(), idx);
+			}
+
+			void GetVerticesIDOfEdge(const size_t i, size_t &t_ID, size_t &h_ID, const bool is_req = kIsRequired) const {
+				const EdgeT *e = GetEdge(i, is_req);
+				t_ID = e->GetTailVertexID();
+				h_ID = e->GetHeadVertexID();
+			}
+
 			void GetVerticesIDOfEdge(const GraphEdge &edge, size_t &t, size_t &h) const {
 				GetVerticesIDOfEdge(edge.edge_index_, t, h, edge.req_);
 				if(edge.rev_) {
 					std::swap(t, h);
 				}
 			}
-			void GetVertexCoordinateofEdge(const size_t, Vec2d &, Vec2d &, const bool is_req = kIsRequired) const ;
+
+			/*! Get coordinates of the Vertices of Edge e */
+			void GetVertexCoordinateofEdge(const size_t i, Vec2d &t_xy, Vec2d &h_xy, const bool is_req = kIsRequired) const {
+				size_t t, h;
+				GetVerticesIndexOfEdge(i, t, h, is_req);
+				GetVertexXY(t, t_xy);
+				GetVertexXY(h, h_xy);
+			}
+
 			void GetVertexCoordinateofEdge(const GraphEdge &edge, Vec2d &t_xy, Vec2d &h_xy) const {
 				GetVertexCoordinateofEdge(edge.edge_index_, t_xy, h_xy, edge.req_);
 				if(edge.rev_) {
@@ -306,62 +789,146 @@ namespace lclibrary {
 				}
 			}
 
-			void GetVertexLLAofEdge(const size_t, double t_LLA[3], double h_LLA[3], const bool is_req = kIsRequired) const ;
+			void GetVertexLLAofEdge(const size_t i, double t_LLA[3], double h_LLA[3], const bool is_req = kIsRequired) const {
+				size_t t, h;
+				GetVerticesIndexOfEdge(i, t, h, is_req);
+				GetVertexLLA(t, t_LLA);
+				GetVertexLLA(h, h_LLA);
+			}
 
 			/* ************************* */
 
 			/* ************************* */
 			/* Edge related functions */
-			inline const Edge * GetEdge(const size_t i, const bool is_req = kIsRequired) const {
+			inline const EdgeT * GetEdge(const size_t i, const bool is_req = kIsRequired) const {
 				if (is_req)
 					return required_edge_list_[i];
 				else
 					return non_required_edge_list_[i];
 			}
 
-			inline void GetEdgeData (const size_t i, Edge &e, const bool is_req = kIsRequired) const {
+			inline void GetEdgeData (const size_t i, EdgeT &e, const bool is_req = kIsRequired) const {
 				if (is_req)
 					e = (*required_edge_list_[i]);
 				else
 					e = (*non_required_edge_list_[i]);
 			}
 
-			int AddEdge(const size_t, const size_t, const bool req = kIsRequired);
-			int AddEdge(const std::vector <Edge> &);
-			int AddEdge(const std::vector <Edge> &, const size_t, const size_t);
-			int AddReverseEdges();
+			/*! Add edge given IDs of the corresponding vertices */
+			int AddEdge(const size_t v1_ID, const size_t v2_ID, const bool req = kIsRequired) {
+				VertexT *v1, *v2;
+				if (GetVertex(v1_ID, v1))
+					return kFail;
+				if (GetVertex(v2_ID, v2))
+					return kFail;
 
-			void ClearAllEdges() {
-				for(auto &e:required_edge_list_) {
-					delete e;
+				EdgeT* new_edge = edge_arena_.Create(v1, v2, req);
+				if (req) {
+					required_edge_list_.push_back(new_edge);
+				}
+				else {
+					non_required_edge_list_.push_back(new_edge);
+				}
+				UpdateEdgeCounts();
+				if(AdjacencyListGeneration() == kFail) {
+					std::cerr << "Adjacency list generation failed after adding edge\n";
+					return kFail;
+				}
+				return kSuccess;
+			}
+
+			int AddEdge(const std::vector <EdgeT> &edge_list_i) {
+				edge_arena_.Reserve(edge_list_i.size());
+				for (size_t i = 0; i < edge_list_i.size(); ++i) {
+					EdgeT *new_edge = CopyEdge(edge_list_i[i]);
+					if(new_edge == nullptr) {
+						std::cerr << "Edge list error" << std::endl;
+						return kFail;
+					}
+					if(new_edge->GetReq()) {
+						required_edge_list_.push_back(new_edge);
+					}
+					else {
+						non_required_edge_list_.push_back(new_edge);
+					}
+				}
+				UpdateEdgeCounts();
+				AdjacencyListGeneration();
+				return kSuccess;
+			}
+
+			int AddEdge(const std::vector <EdgeT> &edge_list_i, const size_t m_i, const size_t m_nr_i) {
+				required_edge_list_.reserve(m_i);
+				non_required_edge_list_.reserve(m_nr_i);
+				return AddEdge(edge_list_i);
+			}
+
+			int AddReverseEdges() {
+				edge_arena_.Reserve(m_ + m_nr_);
+				for (size_t i = 0; i < m_; ++i) {
+					auto e = required_edge_list_[i];
+					EdgeT *new_edge = edge_arena_.Create(*e);
+					new_edge->Reverse();
+					required_edge_list_.push_back(new_edge);
 				}
-				for(auto &e:non_required_edge_list_) {
-					delete e;
+				for (size_t i = 0; i < m_nr_; ++i) {
+					auto e = non_required_edge_list_[i];
+					EdgeT *new_edge = edge_arena_.Create(*e);
+					new_edge->Reverse();
+					non_required_edge_list_.push_back(new_edge);
 				}
+				UpdateEdgeCounts();
+				AdjacencyListGeneration();
+				return kSuccess;
+			}
+
+			void ClearAllEdges() {
 				required_edge_list_.clear();
 				non_required_edge_list_.clear();
+				edge_arena_.Clear();
+				AdjacencyListGeneration();
+			}
+
+			/* ************************* */
+
+			/* ************************* */
+			/* Adjacency related functions */
+
+			/*! Indices of the edges with tail v, in the order of the edge list */
+			inline IndexSpan GetOutEdges(const size_t v, const bool is_req = kIsRequired) const {
+				const size_t k = AdjacencySlot(is_req);
+				const size_t *edges = out_edges_[k].data();
+				return IndexSpan(edges + out_offsets_[k][v], edges + out_offsets_[k][v + 1]);
+			}
+
+			/*! Indices of the edges with tail or head v, in the order of the edge list. A loop at v is listed twice. */
+			inline IndexSpan GetIncidentEdges(const size_t v, const bool is_req = kIsRequired) const {
+				const size_t k = AdjacencySlot(is_req);
+				const size_t *edges = incident_edges_[k].data();
+				return IndexSpan(edges + incident_offsets_[k][v], edges + incident_offsets_[k][v + 1]);
+			}
+
+			/*! Number of required and non-required edges with tail v */
+			inline size_t GetOutDegree(const size_t v) const {
+				return GetOutEdges(v, kIsRequired).size() + GetOutEdges(v, kIsNotRequired).size();
 			}
 
 			/* ************************* */
 
 			inline double GetCost(const size_t i) const  {
-				return required_edge_list_[i]->GetCost();
+				return edge_store_[0].Cost(i);
 			}
 
 			inline double GetServiceCost(const size_t i, const bool is_rev) const  {
-				if(is_rev == false) {
-					return required_edge_list_[i]->GetServiceCost();
-				} else {
-					return required_edge_list_[i]->GetReverseServiceCost();
-				}
+				return edge_store_[0].ServiceCost(i, is_rev);
 			}
 
 			inline double GetServiceCost(const size_t i) const  {
-				return required_edge_list_[i]->GetServiceCost();
+				return edge_store_[0].ServiceCost(i, false);
 			}
 
 			inline double GetReverseServiceCost(const size_t i) const  {
-				return required_edge_list_[i]->GetReverseServiceCost();
+				return edge_store_[0].ServiceCost(i, true);
 			}
 
 			inline double GetCost(const GraphEdge &edge) const {
@@ -373,50 +940,42 @@ namespace lclibrary {
 			}
 
 			inline double GetDeadheadCost(const size_t i, const bool is_req, const bool is_rev) const {
-				if(is_req) {
-					if(is_rev) {
-						return required_edge_list_[i]->GetReverseDeadheadCost();
-					} else {
-						return required_edge_list_[i]->GetDeadheadCost();
-					}
-				} else {
-					if(is_rev) {
-						return non_required_edge_list_[i]->GetReverseDeadheadCost();
-					} else {
-						return non_required_edge_list_[i]->GetDeadheadCost();
-					}
-				}
+				return edge_store_[AdjacencySlot(is_req)].DeadheadCost(i, is_rev);
 			}
 
 			inline double GetDeadheadCost(const size_t i, const bool is_req = kIsRequired) const  {
-				if (is_req)
-					return required_edge_list_[i]->GetDeadheadCost();
-				else
-					return non_required_edge_list_[i]->GetDeadheadCost();
+				return edge_store_[AdjacencySlot(is_req)].DeadheadCost(i, false);
 			}
 
 			inline double GetReverseDeadheadCost(const size_t i, const bool is_req = kIsRequired) const  {
-				if (is_req)
-					return required_edge_list_[i]->GetReverseDeadheadCost();
-				else
-					return non_required_edge_list_[i]->GetReverseDeadheadCost();
+				return edge_store_[AdjacencySlot(is_req)].DeadheadCost(i, true);
 			}
 
-			inline void SetCost(const size_t i, const double c) { required_edge_list_[i]->SetCost(c); }
+			inline void SetCost(const size_t i, const double c) { required_edge_list_[i]->SetCost(c); StoreEdge(i, kIsRequired); }
 			inline void SetCosts(const size_t i, const double c, bool is_req = kIsRequired) {
 				if(is_req == kIsRequired)
 					required_edge_list_[i]->SetCosts(c);
 				else
 					non_required_edge_list_[i]->SetCosts(c);
+				StoreEdge(i, is_req);
+			}
+			inline void SetServiceCost(const size_t i, const double c_s) { required_edge_list_[i]->SetServiceCost(c_s); StoreEdge(i, kIsRequired); }
+			inline void SetServiceCost(const size_t i, const double c_s, double c_srev) { required_edge_list_[i]->SetServiceCost(c_s, c_srev); StoreEdge(i, kIsRequired); }
+
+			/*! The shape points are ordered from the tail to the head of the edge; the costs are not changed */
+			inline void SetEdgeShape(const size_t i, const std::shared_ptr <const EdgeShape> &shape, const bool is_req = kIsRequired) {
+				if (is_req == kIsRequired)
+					required_edge_list_[i]->SetShape(shape);
+				else
+					non_required_edge_list_[i]->SetShape(shape);
 			}
-			inline void SetServiceCost(const size_t i, const double c_s) { required_edge_list_[i]->SetServiceCost(c_s); }
-			inline void SetServiceCost(const size_t i, const double c_s, double c_srev) { required_edge_list_[i]->SetServiceCost(c_s, c_srev); }
 
 			inline void SetDeadheadCost(const size_t i, const double c_d, const bool is_req = kIsRequired) {
 				if (is_req == kIsRequired)
 					required_edge_list_[i]->SetDeadheadCost(c_d);
 				else
 					non_required_edge_list_[i]->SetDeadheadCost(c_d);
+				StoreEdge(i, is_req);
 			}
 
 			inline void SetDeadheadCost(const size_t i, const double c_d, const double c_drev, const bool is_req = kIsRequired) {
@@ -424,43 +983,39 @@ namespace lclibrary {
 					required_edge_list_[i]->SetDeadheadCost(c_d, c_drev);
 				else
 					non_required_edge_list_[i]->SetDeadheadCost(c_d, c_drev);
+				StoreEdge(i, is_req);
 			}
 
 			inline double GetDemand(const size_t i) const  {
-				return required_edge_list_[i]->GetDemand();
+				return edge_store_[0].Demand(i);
 			}
 
 			inline double GetServiceDemand(const size_t i) const  {
-				return required_edge_list_[i]->GetServiceDemand();
+				return edge_store_[0].ServiceDemand(i, false);
 			}
 
 			inline double GetReverseServiceDemand(const size_t i) const  {
-				return required_edge_list_[i]->GetReverseServiceDemand();
+				return edge_store_[0].ServiceDemand(i, true);
 			}
 
 			inline double GetDeadheadDemand(const size_t i, const bool is_req = kIsRequired) const  {
-				if (is_req == kIsRequired)
-					return required_edge_list_[i]->GetDeadheadDemand();
-				else
-					return non_required_edge_list_[i]->GetDeadheadDemand();
+				return edge_store_[AdjacencySlot(is_req)].DeadheadDemand(i, false);
 			}
 
 			inline double GetReverseDeadheadDemand(const size_t i, const bool is_req = kIsRequired) const  {
-				if (is_req == kIsRequired)
-					return required_edge_list_[i]->GetReverseDeadheadDemand();
-				else
-					return non_required_edge_list_[i]->GetReverseDeadheadDemand();
+				return edge_store_[AdjacencySlot(is_req)].DeadheadDemand(i, true);
 			}
 
-			inline void SetDemand(const size_t i, const double q) { required_edge_list_[i]->SetDemand(q); }
-			inline void SetServiceDemand(const size_t i, const double q_s) { required_edge_list_[i]->SetServiceDemands(q_s, q_s); }
-			inline void SetServiceDemand(const size_t i, const double q_s, double q_srev) { required_edge_list_[i]->SetServiceDemands(q_s, q_srev); }
+			inline void SetDemand(const size_t i, const double q) { required_edge_list_[i]->SetDemand(q); StoreEdge(i, kIsRequired); }
+			inline void SetServiceDemand(const size_t i, const double q_s) { required_edge_list_[i]->SetServiceDemands(q_s, q_s); StoreEdge(i, kIsRequired); }
+			inline void SetServiceDemand(const size_t i, const double q_s, double q_srev) { required_edge_list_[i]->SetServiceDemands(q_s, q_srev); StoreEdge(i, kIsRequired); }
 
 			inline void SetDeadheadDemand(const size_t i, const double q_d, const bool is_req = kIsRequired) {
 				if (is_req)
 					required_edge_list_[i]->SetDeadheadDemands(q_d, q_d);
 				else
 					non_required_edge_list_[i]->SetDeadheadDemands(q_d, q_d);
+				StoreEdge(i, is_req);
 			}
 
 			inline void SetDeadheadDemand(const size_t i, const double q_d, const double q_drev, const bool is_req = kIsRequired) {
@@ -470,15 +1025,61 @@ namespace lclibrary {
 				else {
 					non_required_edge_list_[i]->SetDeadheadDemands(q_d, q_drev);
 				}
+				StoreEdge(i, is_req);
 			}
 
 			inline void SetCapacity(double q) { capacity_ = q; }
 			inline double GetCapacity() const { return capacity_; }
 			/* ************************* */
 
-			double ComputeArea() const;
-			void GetLimits(double &, double &, double &, double &) const;
-			void ShiftOrigin();
+			double ComputeArea() const {
+				double minX, minY, maxX, maxY;
+				GetLimits(minX, maxX, minY, maxY);
+				return (maxX - minX ) * (maxY - minY);
+			}
+
+			void GetLimits(double &minX, double &maxX, double &minY, double &maxY) const {
+				minX = DBL_MAX; minY = DBL_MAX; maxX = -DBL_MAX; maxY = -DBL_MAX;
+				for (const auto &x:vertices_->vertex_store_.x_) {
+					minX = std::min(minX, x);
+					maxX = std::max(maxX, x);
+				}
+				for (const auto &y:vertices_->vertex_store_.y_) {
+					minY = std::min(minY, y);
+					maxY = std::max(maxY, y);
+				}
+			}
+
+			void ShiftOrigin() {
+				double minX, maxX, minY, maxY;
+				GetLimits(minX, maxX, minY, maxY);
+				auto &vertices = UnshareVertices();
+				for(size_t i = 0; i < n_; ++i) {
+					auto xy = vertices.vertex_list_[i]->GetXY();
+					vertices.vertex_list_[i]->SetXY(xy.x - minX, xy.y - minY);
+					vertices.vertex_store_.Set(i, *vertices.vertex_list_[i]);
+				}
+				for(const EdgeTList *edge_list:{&required_edge_list_, &non_required_edge_list_}) {
+					for(auto &e:*edge_list) {
+						e->ShiftShape(minX, minY);
+					}
+				}
+			}
+
+			/*! Approximate bytes held by the graph. The vertices may be shared with copies and subgraphs; if with_shared_vertices is false, they are only counted when no other graph shares them. */
+			size_t MemoryFootprint(const bool with_shared_vertices = true) const {
+				size_t bytes = sizeof(*this) + edge_arena_.GetMemoryBytes() + VectorBytes(required_edge_list_) + VectorBytes(non_required_edge_list_) + VectorBytes(depot_list_);
+				for(size_t k = 0; k < 2; ++k) {
+					bytes += VectorBytes(out_offsets_[k]) + VectorBytes(out_edges_[k]) + VectorBytes(incident_offsets_[k]) + VectorBytes(incident_edges_[k]);
+					bytes += edge_store_[k].MemoryFootprint();
+				}
+				if(with_shared_vertices or vertices_.use_count() == 1) {
+					const auto &vertices = *vertices_;
+					bytes += sizeof(vertices) + vertices.vertex_arena_.GetMemoryBytes() + VectorBytes(vertices.vertex_list_) + HashMapBytes(vertices.vertex_map_);
+					bytes += vertices.vertex_store_.MemoryFootprint();
+				}
+				return bytes;
+			}
 
 			inline size_t GetN() const { return n_; }
 			inline size_t GetM() const { return m_; }
@@ -486,11 +1087,10 @@ namespace lclibrary {
 
 			double GetCost () const {
 				double cost = 0;
-				for (auto &e : required_edge_list_) {
-					cost += e->GetCost();
-				}
-				for (auto &e : non_required_edge_list_) {
-					cost += e->GetCost();
+				for(const auto &store:edge_store_) {
+					for(const auto &c:store.cost_) {
+						cost += c;
+					}
 				}
 				return cost;
 			}
@@ -509,6 +1109,7 @@ namespace lclibrary {
 				for(auto e:non_required_edge_list_) {
 					e->ComputeCost();
 				}
+				StoreEdges();
 			}
 
 			void SetRampEdgeCosts(const double acc, const double vel) {
@@ -518,6 +1119,7 @@ namespace lclibrary {
 				for(auto e:non_required_edge_list_) {
 					e->ComputeTravelTimeRamp(acc, vel);
 				}
+				StoreEdges();
 			}
 
 			void SetDemandsToCosts() {
@@ -527,17 +1129,24 @@ namespace lclibrary {
 				for(auto e:non_required_edge_list_) {
 					e->SetDemandsToCosts();
 				}
+				StoreEdges();
 			}
 
+			/*! Length of the required edges, along their shape points if they have any */
 			double GetLength() const{
-				Vec2d u, v;
 				double length = 0;
 				for(size_t i = 0; i < m_; ++i) {
-					GetVertexCoordinateofEdge(i, u, v, kIsRequired);
-					length += u.Dist(v);
+					length += required_edge_list_[i]->GetLength();
 				}
 				return length;
 			}
 	};
+
+	/*! The graph used throughout the library: every vertex has XY and LLA coordinates, and every edge asymmetric service and deadhead costs and demands */
+	typedef BasicGraph <Vertex, Edge> Graph;
+
+	/*! Instantiated once, in src/core/graph.cc */
+	extern template class BasicGraph <Vertex, Edge>;
+
 } // namespace lclibrary
 #endif /*  LCLIBRARY_CORE_GRAPH_H_*/
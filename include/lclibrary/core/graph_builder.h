@@ -0,0 +1,81 @@
+/**
+ * This file is part of the LineCoverage-library.
+ * The file contains GraphBuilder, which collects vertices and edges and assembles a Graph from them in one pass
+ *
+ * TODO:
+ *
+ * @author Saurav Agarwal
+ * @contact sagarw10@uncc.edu
+ * @contact agr.saurav1@gmail.com
+ * Repository: https://github.com/UNCCharlotte-Robotics/LineCoverage-library
+ *
+ * Copyright (C) 2020--2022 University of North Carolina at Charlotte.
+ * The LineCoverage-library is owned by the University of North Carolina at Charlotte and is protected by United States copyright laws and applicable international treaties and/or conventions.
+ *
+ * The LineCoverage-library is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * DISCLAIMER OF WARRANTIES: THE SOFTWARE IS PROVIDED "AS-IS" WITHOUT WARRANTY OF ANY KIND INCLUDING ANY WARRANTIES OF PERFORMANCE OR MERCHANTABILITY OR FITNESS FOR A PARTICULAR USE OR PURPOSE OR OF NON-INFRINGEMENT. YOU BEAR ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE SOFTWARE OR HARDWARE.
+ *
+ * SUPPORT AND MAINTENANCE: No support, installation, or training is provided.
+ *
+ * You should have received a copy of the GNU General Public License along with LineCoverage-library. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LCLIBRARY_CORE_GRAPH_BUILDER_H_
+#define LCLIBRARY_CORE_GRAPH_BUILDER_H_
+
+#include <lclibrary/core/constants.h>
+#include <lclibrary/core/graph.h>
+
+#include <vector>
+#include <memory>
+#include <utility>
+
+namespace lclibrary {
+
+	/*! Collects the vertices and edges of a graph, e.g. from a loader, and assembles the graph with BasicGraph::AssembleGraph().
+	 * Lists given as rvalues are taken over without copying. The lists are released once the graph is built. */
+	template <typename GraphT>
+	class BasicGraphBuilder {
+		typedef typename GraphT::VertexType VertexT;
+		typedef typename GraphT::EdgeType EdgeT;
+
+		std::vector <VertexT> vertex_list_;
+		std::vector <EdgeT> edge_list_;
+
+		public:
+		BasicGraphBuilder() {}
+		BasicGraphBuilder(std::vector <VertexT> &&vertex_list, std::vector <EdgeT> &&edge_list) : vertex_list_{std::move(vertex_list)}, edge_list_{std::move(edge_list)} {}
+
+		void Reserve(const size_t n, const size_t m) {
+			vertex_list_.reserve(n);
+			edge_list_.reserve(m);
+		}
+
+		void SetVertices(std::vector <VertexT> &&vertex_list) { vertex_list_ = std::move(vertex_list); }
+		void SetEdges(std::vector <EdgeT> &&edge_list) { edge_list_ = std::move(edge_list); }
+
+		void AddVertex(const VertexT &v) { vertex_list_.push_back(v); }
+		void AddEdge(const EdgeT &e) { edge_list_.push_back(e); }
+
+		inline size_t GetNumVertices() const { return vertex_list_.size(); }
+		inline size_t GetNumEdges() const { return edge_list_.size(); }
+
+		/*! Creates g from the collected vertices and edges. Repeated vertex IDs and edges with unknown vertex IDs are reported together; on the latter kFail is returned and g is not changed. */
+		int Build(std::shared_ptr <GraphT> &g) {
+			auto new_g = std::make_shared <GraphT>();
+			if(new_g->AssembleGraph(vertex_list_, edge_list_)) {
+				return kFail;
+			}
+			std::vector <VertexT>().swap(vertex_list_);
+			std::vector <EdgeT>().swap(edge_list_);
+			g = new_g;
+			return kSuccess;
+		}
+	};
+
+	typedef BasicGraphBuilder <Graph> GraphBuilder;
+
+} // namespace lclibrary
+
+#endif /* LCLIBRARY_CORE_GRAPH_BUILDER_H_ */
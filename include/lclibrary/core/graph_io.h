@@ -28,6 +28,7 @@
 #include <lclibrary/core/vertex.h>
 #include <lclibrary/core/edge.h>
 #include <lclibrary/core/graph.h>
+#include <lclibrary/core/graph_builder.h>
 #include <lclibrary/algorithms/required_graph.h>
 
 namespace lclibrary {
@@ -50,6 +51,29 @@ namespace lclibrary {
 			const bool,
 			const bool);
 
+	/*! Create graph from a file in the binary format, see WriteGraphBinary() */
+	int CreateGraph(
+			std::shared_ptr <Graph> &,
+			const std::string &);
+
+	/*! Binary format holding the vertices, the required and non-required edges with all their costs and demands, and the depots. The file is checksummed and is read with a single mmap. */
+	int WriteGraphBinary(
+			std::shared_ptr <const Graph>,
+			const std::string &);
+
+	int ReadGraphBinary(
+			std::shared_ptr <Graph> &,
+			const std::string &);
+
+	/*! Converts the text node and edge lists to the binary format; the non-required edge list may be empty */
+	int ConvertGraphToBinary(
+			const std::string &,
+			const std::string &,
+			const std::string &,
+			const std::string &,
+			const bool,
+			const bool);
+
 	void WriteGraphInfo (std::shared_ptr <const Graph> ,
 			const std::string &);
 
@@ -60,18 +84,64 @@ namespace lclibrary {
 
 	void WriteRequiredEdges(
 			std::shared_ptr <const Graph> ,
-			const std::string);
+			const std::string,
+			const bool is_with_cost = kIsWithCost);
 
 	void WriteNonRequiredEdges(
 			std::shared_ptr <const Graph> ,
 			const std::string);
 
+	/*! Shape points of the required edges, see ContractShapeVertices(). Each line is the index, tail ID and head ID of an edge with shape points, their number, and for each point its ID, XY and LLA. */
+	void WriteEdgeShapes(
+			std::shared_ptr <const Graph> ,
+			const std::string &);
+
+	/*! Sets the shape points of the required edges of a graph created from the edge list written with the shapes; the costs are not changed */
+	int ReadEdgeShapes(
+			std::shared_ptr <Graph> &,
+			const std::string &);
+
 	void VertexParser (
 			std::vector <Vertex> &,
-			const std::ifstream &,
+			std::ifstream &,
+			const bool is_with_lla = kIsWithLLA);
+
+	/*! The parsers taking file names map the files into memory and parse large files in parallel. They return kFail if a file cannot be opened. */
+	int VertexParser (
+			std::vector <Vertex> &,
+			const std::string &,
 			const bool is_with_lla = kIsWithLLA);
 
-	void FileParser (
+	int EdgeParser (
+			std::vector <Edge> &,
+			const std::string &,
+			const bool,
+			const bool,
+			size_t &);
+
+	/*! Keeps the vertices that are incident to an edge */
+	void FilterVertices (
+			std::vector <Vertex> &,
+			const std::vector <Edge> &);
+
+	int FileParser (
+			std::shared_ptr<Graph> &,
+			const std::string &,
+			const std::string &,
+			const bool,
+			const bool,
+			const bool filter_vertices = false);
+
+	int FileParser (
+			std::shared_ptr<Graph> &,
+			const std::string &,
+			const std::string &,
+			const std::string &,
+			const bool,
+			const bool,
+			const bool filter_vertices = false);
+
+	int FileParser (
 			std::shared_ptr<Graph> &,
 			std::ifstream &,
 			std::ifstream &,
@@ -79,7 +149,7 @@ namespace lclibrary {
 			const bool,
 			const bool filter_vertices = false);
 
-	void FileParser (
+	int FileParser (
 			std::shared_ptr<Graph> &,
 			std::ifstream &,
 			std::ifstream &,
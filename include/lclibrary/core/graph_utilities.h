@@ -25,6 +25,7 @@
 #include <lclibrary/core/graph.h>
 #include <lclibrary/core/edge_cost_base.h>
 #include <memory>
+#include <vector>
 
 namespace lclibrary {
 
@@ -37,6 +38,9 @@ namespace lclibrary {
 	/* Compute edge costs for all the edges using an EdgeCost based object */
 	int ComputeAllEdgeCosts(std::shared_ptr <Graph> &, EdgeCost &);
 
+	/* Replace the chains of required edges through shape vertices, i.e. vertices that are not depots and whose only edges are two required edges, by single edges. The shape vertices are kept as the shape points of the new edge, whose costs and demands are the sums over the chain. The vertices with IDs in kept_vertex_IDs, e.g. depots that are set only after the conversion, are never contracted. */
+	int ContractShapeVertices(std::shared_ptr <Graph> &, const std::vector <size_t> &kept_vertex_IDs = std::vector <size_t>());
+
 }
 
 #endif /* GRAPH_UTILITIES_UTILITIES_H_ */
@@ -31,20 +31,77 @@
 #include <lclibrary/utils/edge_cost_travel_time.h>
 #include <lclibrary/utils/edge_cost_with_circular_turns.h>
 
+#include <filesystem>
 #include <memory>
 
 namespace lclibrary {
 
-	inline int GraphCreate(const Config &config, std::shared_ptr <Graph> &g) {
-		if(CreateGraph(g, config.database.dir + config.filenames.nodes_data, config.database.dir + config.filenames.req_edges, config.input_graph.lla, config.input_graph.costs) == kFail) {
+	/* The shapes are only in the text file, so they are read for the binary graph as well; a graph without contracted edges has no shapes file */
+	inline int GraphReadEdgeShapes(const Config &config, std::shared_ptr <Graph> &g) {
+		const std::string edge_shapes_file = config.database.dir + config.filenames.edge_shapes;
+		if(not config.simplify_chains or not std::filesystem::exists(edge_shapes_file)) {
+			return kSuccess;
+		}
+		return ReadEdgeShapes(g, edge_shapes_file);
+	}
+
+	/* The binary file is written after the pairwise non-required edges are added, so later runs load them instead of computing them again. It is written again if it is older than the text files, or if it holds non-required edges that the config does not ask for. */
+	inline int GraphCreateBinary(const Config &config, std::shared_ptr <Graph> &g) {
+		const std::string nodes_file = config.database.dir + config.filenames.nodes_data;
+		const std::string req_edges_file = config.database.dir + config.filenames.req_edges;
+		const std::string binary_file = config.database.dir + config.filenames.graph_binary;
+		std::error_code ec;
+		const bool is_current = std::filesystem::exists(binary_file, ec) and std::filesystem::last_write_time(binary_file, ec) >= std::filesystem::last_write_time(nodes_file, ec) and std::filesystem::last_write_time(binary_file, ec) >= std::filesystem::last_write_time(req_edges_file, ec);
+		if(is_current) {
+			if(CreateGraph(g, binary_file) == kFail) {
+				std::cerr << "Graph creation failed\n";
+				return kFail;
+			}
+			if(config.add_pairwise_nonreq_edges and g->GetMnr() == 0) {
+				AddReducedCompleteNonRequiredEdges(g);
+				if(WriteGraphBinary(g, binary_file) == kFail) {
+					std::cerr << "Could not write the binary graph " << binary_file << std::endl;
+				}
+			}
+			if(config.add_pairwise_nonreq_edges or g->GetMnr() == 0) {
+				return kSuccess;
+			}
+		}
+
+		if(CreateGraph(g, nodes_file, req_edges_file, config.input_graph.lla, config.input_graph.costs) == kFail) {
 			std::cerr << "Graph creation failed\n";
 			return kFail;
 		}
-
 		if(config.add_pairwise_nonreq_edges) {
-			/* AddCompleteNonRequiredEdges(g); */
 			AddReducedCompleteNonRequiredEdges(g);
 		}
+		if(WriteGraphBinary(g, binary_file) == kFail) {
+			std::cerr << "Could not write the binary graph " << binary_file << std::endl;
+		}
+		return kSuccess;
+	}
+
+	inline int GraphCreate(const Config &config, std::shared_ptr <Graph> &g) {
+		if(not config.filenames.graph_binary.empty()) {
+			if(GraphCreateBinary(config, g) == kFail) {
+				return kFail;
+			}
+		} else {
+			if(CreateGraph(g, config.database.dir + config.filenames.nodes_data, config.database.dir + config.filenames.req_edges, config.input_graph.lla, config.input_graph.costs) == kFail) {
+				std::cerr << "Graph creation failed\n";
+				return kFail;
+			}
+
+			if(config.add_pairwise_nonreq_edges) {
+				/* AddCompleteNonRequiredEdges(g); */
+				AddReducedCompleteNonRequiredEdges(g);
+			}
+		}
+
+		if(GraphReadEdgeShapes(config, g) == kFail) {
+			std::cerr << "Edge shapes could not be read\n";
+			return kFail;
+		}
 
 		if(config.depot_mode == Config::DepotMode::mean) {
 			if(g->SetMeanDepot() == kFail) {
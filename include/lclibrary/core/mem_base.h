@@ -85,6 +85,7 @@ namespace lclibrary {
 
 	class MEM_Base {
 		SavingsHeap savings_heap_;
+		size_t savings_peak_bytes_ = 0; /* Largest memory held by the savings, reached when the heap is built from the initial savings */
 
 		virtual void InitializeRoutes() = 0;
 		virtual bool ComputeSavings(RouteSavings &) = 0;
@@ -109,6 +110,7 @@ namespace lclibrary {
 				}
 			}
 			savings_heap_ = SavingsHeap(initial_savings.begin(), initial_savings.end());
+			savings_peak_bytes_ = VectorBytes(initial_savings) + savings_heap_.size() * sizeof(RouteSavings);
 
 			/* int count = 0; */
 			while(!savings_heap_.empty()) {
@@ -129,8 +131,11 @@ namespace lclibrary {
 						savings_heap_.push(rs);
 					}
 				}
+				savings_peak_bytes_ = std::max(savings_peak_bytes_, savings_heap_.size() * sizeof(RouteSavings));
 			}
 		}
+
+		size_t GetSavingsPeakBytes() const { return savings_peak_bytes_; }
 	};
 
 }
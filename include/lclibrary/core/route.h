@@ -39,6 +39,7 @@
 #include <fstream>
 #include <memory>
 #include <algorithm>
+#include <list>
 
 namespace lclibrary {
 	typedef std::list <Edge> RouteEdges;
@@ -198,36 +199,36 @@ namespace lclibrary {
 				return rev_cummulative_costs_[0];
 			}
 			if(has_depot == false and i == 1 and route_vector_[i - 1]->GetReq() != kIsRequired and k == m_ - 1) {
-				g_->GetVertexIndex(route_vector_[0]->GetHeadVertexID(), link_ab_u);
-				g_->GetVertexIndex(route_vector_[0]->GetTailVertexID(), link_ab_v);
+				g_->GetHeadVertexIndex(*route_vector_[0], link_ab_u);
+				g_->GetTailVertexIndex(*route_vector_[0], link_ab_v);
 				return rev_cummulative_costs_[i] + apsp_->GetCost(link_ab_u, link_ab_v);
 			}
 
 			if(i != 0) {
 				if(route_vector_[i - 1]->GetReq() == kIsRequired) {
 					cost = cummulative_costs_[i - 1];
-					g_->GetVertexIndex(route_vector_[i - 1]->GetHeadVertexID(), link_ab_u);
+					g_->GetHeadVertexIndex(*route_vector_[i - 1], link_ab_u);
 				} else {
 					if(i > 1) {
 						cost = cummulative_costs_[i - 2];
-						g_->GetVertexIndex(route_vector_[i - 2]->GetHeadVertexID(), link_ab_u);
+						g_->GetHeadVertexIndex(*route_vector_[i - 2], link_ab_u);
 					}
 				}
 			}
 			if(i == 0 and has_depot) {
-				g_->GetVertexIndex(route_vector_[0]->GetTailVertexID(), link_ab_u);
+				g_->GetTailVertexIndex(*route_vector_[0], link_ab_u);
 			}
 
-			g_->GetVertexIndex(route_vector_[0]->GetTailVertexID(), start_vertex);
+			g_->GetTailVertexIndex(*route_vector_[0], start_vertex);
 			/* std::cout << "parta: " << cost << std::endl; */
 
 			partb_cost = rev_cummulative_costs_[i] - rev_cummulative_costs_[k + 1];
 			/* std::cout << "partb: " << partb_cost << std::endl; */
 			if(route_vector_[k]->GetReq() != kIsRequired) {
 				partb_cost -= route_vector_[k]->GetReverseDeadheadCost();
-				g_->GetVertexIndex(route_vector_[k]->GetTailVertexID(), link_ab_v);
+				g_->GetTailVertexIndex(*route_vector_[k], link_ab_v);
 			} else {
-				g_->GetVertexIndex(route_vector_[k]->GetHeadVertexID(), link_ab_v);
+				g_->GetHeadVertexIndex(*route_vector_[k], link_ab_v);
 			}
 
 			/* std::cout << "partb1: " << partb_cost << std::endl; */
@@ -242,10 +243,10 @@ namespace lclibrary {
 			/* std::cout << "partb2: " << cost << std::endl; */
 
 			if(route_vector_[i]->GetReq() == kIsRequired or (i <= 1 and has_depot)) {
-				g_->GetVertexIndex(route_vector_[i]->GetTailVertexID(), link_bc_u);
+				g_->GetTailVertexIndex(*route_vector_[i], link_bc_u);
 			} else {
 				cost -= route_vector_[i]->GetReverseDeadheadCost();
-				g_->GetVertexIndex(route_vector_[i]->GetHeadVertexID(), link_bc_u);
+				g_->GetHeadVertexIndex(*route_vector_[i], link_bc_u);
 			}
 			/* std::cout << "partb3: " << cost << std::endl; */
 
@@ -258,18 +259,18 @@ namespace lclibrary {
 			/* std::cout << "partc: " << partc_cost << std::endl; */
 			if(route_vector_[k + 1]->GetReq() != kIsRequired) {
 				partc_cost -= route_vector_[k + 1]->GetDeadheadCost();
-				g_->GetVertexIndex(route_vector_[k + 2]->GetTailVertexID(), link_bc_v);
+				g_->GetTailVertexIndex(*route_vector_[k + 2], link_bc_v);
 			} else {
-				g_->GetVertexIndex(route_vector_[k + 1]->GetTailVertexID(), link_bc_v);
+				g_->GetTailVertexIndex(*route_vector_[k + 1], link_bc_v);
 			}
 			cost += partc_cost + apsp_->GetCost(link_bc_u, link_bc_v);
 			/* std::cout << "partc + dd: " << cost << " " << link_bc_u << " " << link_bc_v<< std::endl; */
 
 			if(route_vector_[m_ - 1]->GetReq() != kIsRequired) {
 				cost -= route_vector_[m_ - 1]->GetDeadheadCost();
-				g_->GetVertexIndex(route_vector_[m_ - 1]->GetTailVertexID(), end_vertex);
+				g_->GetTailVertexIndex(*route_vector_[m_ - 1], end_vertex);
 			} else {
-				g_->GetVertexIndex(route_vector_[m_ - 1]->GetHeadVertexID(), end_vertex);
+				g_->GetHeadVertexIndex(*route_vector_[m_ - 1], end_vertex);
 			}
 			cost += apsp_->GetCost(end_vertex, start_vertex);
 			/* std::cout << "final: " << cost << " " << end_vertex << " " << start_vertex<< std::endl; */
@@ -364,9 +365,8 @@ namespace lclibrary {
 			size_t u_id, v_id;
 			if(route_.size() == 1) {
 				Edge e = route_.front();
-				u = e.GetTailVertexID(); v = e.GetHeadVertexID();
-				g_->GetVertexIndex(u, u_id);
-				g_->GetVertexIndex(v, v_id);
+				g_->GetTailVertexIndex(e, u_id);
+				g_->GetHeadVertexIndex(e, v_id);
 				std::vector <Edge> edge_list;
 				if(g_->IsDepotSet()) {
 				}
@@ -380,8 +380,8 @@ namespace lclibrary {
 				u = it->GetHeadVertexID();
 				v = next_it->GetTailVertexID();
 				if(u != v) {
-					g_->GetVertexIndex(u, u_id);
-					g_->GetVertexIndex(v, v_id);
+					g_->GetHeadVertexIndex(*it, u_id);
+					g_->GetTailVertexIndex(*next_it, v_id);
 					std::vector <Edge> edge_list;
 					apsp_->GetPath(edge_list, u_id, v_id);
 					for(const auto &e:edge_list) {
@@ -395,8 +395,8 @@ namespace lclibrary {
 			Edge e_back = route_.back();
 			u = e_back.GetHeadVertexID(); v = e_front.GetTailVertexID();
 			if(u != v) {
-				g_->GetVertexIndex(u, u_id);
-				g_->GetVertexIndex(v, v_id);
+				g_->GetHeadVertexIndex(e_back, u_id);
+				g_->GetTailVertexIndex(e_front, v_id);
 				std::vector <Edge> edge_list;
 				apsp_->GetPath(edge_list, u_id, v_id);
 				for(const auto &e:edge_list) {
@@ -407,8 +407,8 @@ namespace lclibrary {
 
 		void Shortcut(RouteEdges::const_iterator start_it, RouteEdges::const_iterator end_it, RouteEdges::const_iterator it,  double cost) {
 			size_t t, h;
-			g_->GetVertexIndex(start_it->GetTailVertexID(), t);
-			g_->GetVertexIndex(end_it->GetHeadVertexID(), h);
+			g_->GetTailVertexIndex(*start_it, t);
+			g_->GetHeadVertexIndex(*end_it, h);
 			auto dd_cost = apsp_->GetCost(t, h);
 			RouteEdges::const_iterator insert_it;
 			if(dd_cost < cost) {
@@ -480,8 +480,8 @@ namespace lclibrary {
 				size_t t , h;
 				/* std::cout << "-------------\n"; */
 				/* PrintRoute(); */
-				g_->GetVertexIndex((*std::prev(back_index)).GetHeadVertexID(), t);
-				g_->GetVertexIndex((*front_index).GetTailVertexID(), h);
+				g_->GetHeadVertexIndex(*std::prev(back_index), t);
+				g_->GetTailVertexIndex(*front_index, h);
 				route_.erase(route_.begin(), front_index);
 				route_.erase(back_index, route_.end());
 				/* PrintRoute(); */
@@ -514,33 +514,52 @@ namespace lclibrary {
 			std::rotate(route_.begin(), n_begin, route_.end());
 		}
 
-		/*! Write edge data to file */
+		/*! Cost of the route up to segment k of the polyline of e, given the cost up to e. The cost of an edge with shape points is split over its segments in proportion to their lengths. */
+		static double GetSegmentEndCost(const Edge &e, const size_t k, const double cost_before, double &length_before) {
+			const size_t num_segments = e.GetNumPolylinePoints() - 1;
+			if(k == num_segments) {
+				return cost_before + e.GetCost();
+			}
+			length_before += e.GetPolylinePoint(k - 1).GetXY().Dist(e.GetPolylinePoint(k).GetXY());
+			const double length = e.GetLength();
+			if(length < kEps) {
+				return cost_before + e.GetCost() * k / num_segments;
+			}
+			return cost_before + e.GetCost() * length_before / length;
+		}
+
+		/*! Write edge data to file; an edge with shape points is written as its segments */
 		void WriteRouteData(std::string filename) const {
 			std::ofstream out_file (filename);
 			out_file.precision(16);
 			double cost = 0;
 			for (auto &e:route_) {
+				double length_before = 0;
+				for(size_t k = 1; k < e.GetNumPolylinePoints(); ++k) {
+					out_file << e.GetPolylinePoint(k - 1).GetID() << " " << e.GetPolylinePoint(k).GetID() << " " << e.GetReq()<< " " << GetSegmentEndCost(e, k, cost, length_before);
+					out_file<<"\n";
+				}
 				cost += e.GetCost();
-				out_file << e.GetTailVertexID() << " " << e.GetHeadVertexID() << " " << e.GetReq()<< " " << cost;
-				out_file<<"\n";
 
 			}
 			out_file.close();
 		}
 
-		/*! Write edge data to file */
+		/*! Write edge data to file; an edge with shape points is written as its segments */
 		void WriteRouteEdgeData(std::string filename) const {
 			std::ofstream out_file (filename);
 			out_file.precision(16);
 			double cost = 0;
 			for (auto &e:route_) {
+				double length_before = 0;
+				for(size_t k = 1; k < e.GetNumPolylinePoints(); ++k) {
+					auto t_xy = e.GetPolylinePoint(k - 1).GetXY();
+					auto h_xy = e.GetPolylinePoint(k).GetXY();
+					out_file << t_xy.x << " " << t_xy.y << " ";
+					out_file << h_xy.x << " " << h_xy.y << " " << e.GetReq() << " " << GetSegmentEndCost(e, k, cost, length_before);
+					out_file<<"\n";
+				}
 				cost += e.GetCost();
-				double x, y;
-				e.GetTailVertexXY(x, y);
-				out_file << x << " " << y << " ";
-				e.GetHeadVertexXY(x, y);
-				out_file << x << " " << y << " " << e.GetReq() << " " << cost;
-				out_file<<"\n";
 
 			}
 			out_file.close();
@@ -554,9 +573,11 @@ namespace lclibrary {
 			double x, y;
 			for (const auto &e:route_) {
 				cost += e.GetCost();
-				e.GetTailVertexXY(x, y);
-				out_file << x << " " << y << " " << e.GetReq();
-				out_file<<"\n";
+				for(size_t k = 0; k + 1 < e.GetNumPolylinePoints(); ++k) {
+					auto xy = e.GetPolylinePoint(k).GetXY();
+					out_file << xy.x << " " << xy.y << " " << e.GetReq();
+					out_file<<"\n";
+				}
 
 			}
 			auto e = route_.back();
@@ -592,8 +613,10 @@ namespace lclibrary {
 				auto e = *it;
 				e.GetVertices(t, h);
 				if(t!=nullptr and h!=nullptr) {
-					WritePlacemarkKML(out_file, count, h);
-					++count;
+					for(size_t k = 1; k < e.GetNumPolylinePoints(); ++k) {
+						WritePlacemarkKML(out_file, count, &e.GetPolylinePoint(k));
+						++count;
+					}
 				}
 			}
 			out_file << "</Document>\n </kml>";
@@ -614,8 +637,10 @@ namespace lclibrary {
 				auto e = *it;
 				e.GetVertices(t, h);
 				if(t!=nullptr and h!=nullptr) {
-					WritePlacemarkKML(out_file, count, t);
-					++count;
+					for(size_t k = e.GetNumPolylinePoints() - 1; k-- > 0;) {
+						WritePlacemarkKML(out_file, count, &e.GetPolylinePoint(k));
+						++count;
+					}
 				}
 			}
 			out_file << "</Document>\n </kml>";
@@ -641,6 +666,10 @@ namespace lclibrary {
 			return (route_.size() - 1);
 		}
 
+		size_t MemoryFootprint() const {
+			return ListBytes(route_) + VectorBytes(cummulative_costs_) + VectorBytes(rev_cummulative_costs_) + VectorBytes(route_vector_);
+		}
+
 	};
 } // namespace lclibrary
 
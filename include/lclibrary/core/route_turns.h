@@ -34,6 +34,7 @@
 #include <fstream>
 #include <memory>
 #include <algorithm>
+#include <cmath>
 
 namespace lclibrary {
 
@@ -203,8 +204,19 @@ namespace lclibrary {
 			std::cout << "KE cost: " << total_cost << std::endl;
 		}
 
+		/* The cost is read from the turn cost table of apsp_; the geometry of the turn is computed only when the route actually turns */
 		void ComputeTurnCost(const GraphEdge &prev_edge, const GraphEdge &next_edge, double &cost, CircularTurn &circ_turn) {
-				cost_fn_->ComputeTurnCost(g_->GetEdge(prev_edge.edge_index_, prev_edge.req_), g_->GetEdge(next_edge.edge_index_, next_edge.req_), prev_edge.serv_, next_edge.serv_, prev_edge.rev_, next_edge.rev_, cost, circ_turn);
+			cost = apsp_->GetTurnCostTable()->GetTurnCost(prev_edge, next_edge);
+			if(std::isnan(cost)) {
+				circ_turn.status = -1;
+				return;
+			}
+			if(cost == 0) {
+				circ_turn.status = 0;
+				return;
+			}
+			double geometry_cost;
+			cost_fn_->ComputeTurnCost(g_->GetEdge(prev_edge.edge_index_, prev_edge.req_), g_->GetEdge(next_edge.edge_index_, next_edge.req_), prev_edge.serv_, next_edge.serv_, prev_edge.rev_, next_edge.rev_, geometry_cost, circ_turn);
 		}
 
 		bool CheckRoute() const {
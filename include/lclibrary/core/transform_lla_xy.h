@@ -25,10 +25,23 @@
 #ifndef LCLIBRARY_CORE_TRANSFORM_LLA_XY_H_
 #define LCLIBRARY_CORE_TRANSFORM_LLA_XY_H_
 
+#include <lclibrary/core/constants.h>
+#include <lclibrary/utils/text_record_parser.h>
+#include <lclibrary/utils/thread_pool.h>
+#include <algorithm>
 #include <cmath>
-#include <unordered_map>
+#include <cstdlib>
+#include <functional>
 #include <fstream>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define LCLIBRARY_LLA_XY_X86
+#include <immintrin.h>
+#endif
 
 #define WGS84_EquitorialRadius 6378137.000000
 #define WGS84_PolarSemiMinorAxis 6356752.314245
@@ -44,11 +57,98 @@ xOffset,yOffset : the result in cartesian coordinate x,y (the unit is in meters)
 */
 namespace lclibrary{
 
+	/*! The constants of the projection, which depend only on the reference; angles in radians */
+	struct FlatProjection {
+		double ref_lat, ref_lon, ref_alt;
+		double rad_per_x, rad_per_y; /*! Angle per meter along the parallel and the meridian of the reference */
+	};
+
+	/* The kernels evaluate the same operations in the same order as LLAtoXY::llaToFlat() and LLAtoXY::flatToLLA(), so the vector and scalar results are identical */
+	inline void LLAtoFlatScalar(const FlatProjection &p, const double *lat, const double *lon, const double *alt, double *x, double *y, double *z, const size_t count) {
+		for(size_t i = 0; i < count; ++i) {
+			y[i] = (M_PI * lat[i] / 180.0 - p.ref_lat) / p.rad_per_y;
+			x[i] = (M_PI * lon[i] / 180.0 - p.ref_lon) / p.rad_per_x;
+			z[i] = alt[i] - p.ref_alt;
+		}
+	}
+
+	inline void FlatToLLAScalar(const FlatProjection &p, const double *x, const double *y, const double *z, double *lat, double *lon, double *alt, const size_t count) {
+		for(size_t i = 0; i < count; ++i) {
+			lat[i] = 180.0 * (y[i] * p.rad_per_y + p.ref_lat) / M_PI;
+			lon[i] = 180.0 * (x[i] * p.rad_per_x + p.ref_lon) / M_PI;
+			alt[i] = z[i] + p.ref_alt;
+		}
+	}
+
+#ifdef LCLIBRARY_LLA_XY_X86
+
+	__attribute__((target("avx2"))) inline void LLAtoFlatAVX2(const FlatProjection &p, const double *lat, const double *lon, const double *alt, double *x, double *y, double *z, const size_t count) {
+		const __m256d pi = _mm256_set1_pd(M_PI), half_turn = _mm256_set1_pd(180.0);
+		const __m256d ref_lat = _mm256_set1_pd(p.ref_lat), ref_lon = _mm256_set1_pd(p.ref_lon), ref_alt = _mm256_set1_pd(p.ref_alt);
+		const __m256d rad_per_x = _mm256_set1_pd(p.rad_per_x), rad_per_y = _mm256_set1_pd(p.rad_per_y);
+		size_t i = 0;
+		for(; i + 4 <= count; i += 4) {
+			const __m256d d_lat = _mm256_sub_pd(_mm256_div_pd(_mm256_mul_pd(pi, _mm256_loadu_pd(lat + i)), half_turn), ref_lat);
+			const __m256d d_lon = _mm256_sub_pd(_mm256_div_pd(_mm256_mul_pd(pi, _mm256_loadu_pd(lon + i)), half_turn), ref_lon);
+			_mm256_storeu_pd(y + i, _mm256_div_pd(d_lat, rad_per_y));
+			_mm256_storeu_pd(x + i, _mm256_div_pd(d_lon, rad_per_x));
+			_mm256_storeu_pd(z + i, _mm256_sub_pd(_mm256_loadu_pd(alt + i), ref_alt));
+		}
+		LLAtoFlatScalar(p, lat + i, lon + i, alt + i, x + i, y + i, z + i, count - i);
+	}
+
+	__attribute__((target("avx2"))) inline void FlatToLLAAVX2(const FlatProjection &p, const double *x, const double *y, const double *z, double *lat, double *lon, double *alt, const size_t count) {
+		const __m256d pi = _mm256_set1_pd(M_PI), half_turn = _mm256_set1_pd(180.0);
+		const __m256d ref_lat = _mm256_set1_pd(p.ref_lat), ref_lon = _mm256_set1_pd(p.ref_lon), ref_alt = _mm256_set1_pd(p.ref_alt);
+		const __m256d rad_per_x = _mm256_set1_pd(p.rad_per_x), rad_per_y = _mm256_set1_pd(p.rad_per_y);
+		size_t i = 0;
+		for(; i + 4 <= count; i += 4) {
+			const __m256d lat_rad = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(y + i), rad_per_y), ref_lat);
+			const __m256d lon_rad = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(x + i), rad_per_x), ref_lon);
+			_mm256_storeu_pd(lat + i, _mm256_div_pd(_mm256_mul_pd(half_turn, lat_rad), pi));
+			_mm256_storeu_pd(lon + i, _mm256_div_pd(_mm256_mul_pd(half_turn, lon_rad), pi));
+			_mm256_storeu_pd(alt + i, _mm256_add_pd(_mm256_loadu_pd(z + i), ref_alt));
+		}
+		FlatToLLAScalar(p, x + i, y + i, z + i, lat + i, lon + i, alt + i, count - i);
+	}
+
+#endif /* LCLIBRARY_LLA_XY_X86 */
+
+	inline bool IsLLAtoXYVectorized() {
+#ifdef LCLIBRARY_LLA_XY_X86
+		static const bool is_avx2 = [] { __builtin_cpu_init(); return bool(__builtin_cpu_supports("avx2")); }();
+		return is_avx2;
+#else
+		return false;
+#endif
+	}
+
 	class LLAtoXY {
 		private:
+			/* Below this many points per thread, the batch projections run on the calling thread */
+			static constexpr size_t kMinParallelPoints = size_t(1) << 16;
+
 			double a, b, f;
 			double refLat, refLon, refAlt;
 			double r_n, r_m;
+			FlatProjection projection_;
+
+			static size_t GetNumChunks(const size_t count, const size_t num_threads) {
+				return std::max(size_t(1), std::min(GetNumThreads(num_threads), count / kMinParallelPoints));
+			}
+
+			/* Calls fn(k, begin, end) for the k-th of num_chunks consecutive ranges of [0, count), one thread per range */
+			static void ParallelChunks(const size_t count, const size_t num_chunks, const std::function <void(size_t, size_t, size_t)> &fn) {
+				if(num_chunks == 1) {
+					fn(0, 0, count);
+					return;
+				}
+				ThreadPool pool(num_chunks);
+				pool.ParallelFor(0, num_chunks, [&](const size_t k) {
+						fn(k, count * k / num_chunks, count * (k + 1) / num_chunks);
+						});
+			}
+
 		public:
 			inline double degTorad (double deg){
 				return M_PI * deg / 180.0;
@@ -68,6 +168,7 @@ namespace lclibrary{
 				ralt = refAlt;
 			}
 
+			/*! Computes the constants of the projection once for all the points */
 			void SetRefLatLong(const double rlat, const double rlon, const double ralt) {
 				refLat = degTorad(rlat);
 				refLon = degTorad(rlon);
@@ -81,37 +182,51 @@ namespace lclibrary{
 				double r_n_deno = std::sqrt(r_m_deno);
 				r_n = R / r_n_deno;
 				r_m = r_n * (1.0 - (2.0 * f - f * f)) / r_m_deno;
+				projection_.ref_lat = refLat;
+				projection_.ref_lon = refLon;
+				projection_.ref_alt = refAlt;
+				projection_.rad_per_x = atan(1.0/(r_n * cos (refLat)));
+				projection_.rad_per_y = atan(1.0/r_m);
 			}
 
-			void llaToFlat(double lat, double lon, double alt, double& xOffset, double& yOffset, double& zOffset) {
+			void llaToFlat(double lat, double lon, double alt, double& xOffset, double& yOffset, double& zOffset) const {
+				LLAtoFlatScalar(projection_, &lat, &lon, &alt, &xOffset, &yOffset, &zOffset, 1);
+			}
 
-				double R = WGS84_EquitorialRadius;
-				double sinMu0 = sin(refLat);
-				double sinSqMu0 = sinMu0 * sinMu0;
+			void flatToLLA(double xOffset, double yOffset, double zOffset, double &lat, double &lon, double &alt) const {
+				FlatToLLAScalar(projection_, &xOffset, &yOffset, &zOffset, &lat, &lon, &alt, 1);
+			}
 
-				double f = WGS84_flattening;
-				double r_m_deno = 1.0 - (2.0 * f - f * f) * sinSqMu0;
-				double r_n_deno = std::sqrt(r_m_deno);
-				r_n = R / r_n_deno;
-				r_m = r_n * (1.0 - (2.0 * f - f * f)) / r_m_deno;
-				double dMu = degTorad(lat) - refLat;
-				double dL = degTorad(lon) - refLon;
-				yOffset = dMu/(atan(1.0/r_m));
-				xOffset = dL/(atan(1.0/(r_n * cos (refLat))));
-				zOffset = alt - refAlt;
+			/*! Projects count points with SIMD, in parallel if there are many; latitudes and longitudes in degrees. num_threads = 0 uses all the cores. */
+			void llaToFlat(const size_t count, const double *lat, const double *lon, const double *alt, double *x, double *y, double *z, const size_t num_threads = 0) const {
+				ParallelChunks(count, GetNumChunks(count, num_threads), [&](const size_t, const size_t begin, const size_t end) {
+#ifdef LCLIBRARY_LLA_XY_X86
+						if(IsLLAtoXYVectorized()) {
+							LLAtoFlatAVX2(projection_, lat + begin, lon + begin, alt + begin, x + begin, y + begin, z + begin, end - begin);
+							return;
+						}
+#endif
+						LLAtoFlatScalar(projection_, lat + begin, lon + begin, alt + begin, x + begin, y + begin, z + begin, end - begin);
+						});
 			}
-			void flatToLLA(double xOffset, double yOffset, double zOffset, double &lat, double &lon, double &alt) {
-				double dMu = yOffset * (atan(1.0/r_m));
-				double dL = xOffset * (atan(1.0/(r_n * cos (refLat))));
-				lat = radTodeg(dMu + refLat);
-				lon = radTodeg(dL + refLon);
-				alt = zOffset - refAlt;
+
+			/*! Inverse of the batch llaToFlat() */
+			void flatToLLA(const size_t count, const double *x, const double *y, const double *z, double *lat, double *lon, double *alt, const size_t num_threads = 0) const {
+				ParallelChunks(count, GetNumChunks(count, num_threads), [&](const size_t, const size_t begin, const size_t end) {
+#ifdef LCLIBRARY_LLA_XY_X86
+						if(IsLLAtoXYVectorized()) {
+							FlatToLLAAVX2(projection_, x + begin, y + begin, z + begin, lat + begin, lon + begin, alt + begin, end - begin);
+							return;
+						}
+#endif
+						FlatToLLAScalar(projection_, x + begin, y + begin, z + begin, lat + begin, lon + begin, alt + begin, end - begin);
+						});
 			}
 
-			void parse_write(std::string nodeFileName, std::string outNodeFileName){
-				std::fstream nodeInFile;
-				nodeInFile.open(nodeFileName);
-				if (!nodeInFile) {
+			/*! Reads the nodes with latitude and longitude, and writes them with XY relative to the first node. The file is mapped into memory, and the projection and formatting are split over the cores for large files. */
+			void parse_write(std::string nodeFileName, std::string outNodeFileName, const size_t num_threads = 0){
+				TextRecordParser parser(3, {0});
+				if (parser.Parse(nodeFileName, num_threads) == kFail) {
 					std::cerr << "Unable to open file " << nodeFileName << "\n";
 					exit(1);   // call system to stop
 				}
@@ -122,30 +237,35 @@ namespace lclibrary{
 					std::cerr << "Unable to open file " << outNodeFileName << "\n";
 					exit(1);   // call system to stop
 				}
-				nodeOutFile.precision(16);
 				double dummyAlt = 229;
 
-				std::unordered_map <size_t, size_t> nodeMap;
-				size_t nodeID;
-				double nodeLat, nodeLon;
-				size_t countNode = 0;
-				bool flag = 0;
-				while (nodeInFile >> nodeID){
-					nodeMap[nodeID] = countNode++;
-					nodeInFile >> nodeLat;
-					nodeInFile >> nodeLon;
-					if ( !flag ){
-						flag = 1;
-						refLat = degTorad(nodeLat);
-						refLon = degTorad(nodeLon);;
-						refAlt = dummyAlt;
-					}
-					double xOffset, yOffset, zOffset;
-					llaToFlat(nodeLat, nodeLon, dummyAlt + 50.0, xOffset, yOffset, zOffset);
-					nodeOutFile << nodeID << " " << xOffset << " " << yOffset << " " << nodeLat << " " << nodeLon << " " << zOffset << "\n";
+				const size_t num_nodes = parser.GetNumRecords();
+				if (num_nodes == 0) {
+					return;
+				}
+				SetRefLatLong(parser.GetReal(0, 1), parser.GetReal(0, 2), dummyAlt);
+				std::vector <double> nodeLat(num_nodes), nodeLon(num_nodes), nodeAlt(num_nodes, dummyAlt + 50.0);
+				for (size_t i = 0; i < num_nodes; ++i) {
+					nodeLat[i] = parser.GetReal(i, 1);
+					nodeLon[i] = parser.GetReal(i, 2);
+				}
+				std::vector <double> xOffset(num_nodes), yOffset(num_nodes), zOffset(num_nodes);
+				llaToFlat(num_nodes, nodeLat.data(), nodeLon.data(), nodeAlt.data(), xOffset.data(), yOffset.data(), zOffset.data(), num_threads);
 
+				/* The ranges are formatted in parallel and written in order */
+				const size_t num_chunks = GetNumChunks(num_nodes, num_threads);
+				std::vector <std::string> chunks(num_chunks);
+				ParallelChunks(num_nodes, num_chunks, [&](const size_t k, const size_t begin, const size_t end) {
+						std::ostringstream out;
+						out.precision(16);
+						for (size_t i = begin; i < end; ++i) {
+							out << parser.GetID(i, 0) << " " << xOffset[i] << " " << yOffset[i] << " " << nodeLat[i] << " " << nodeLon[i] << " " << zOffset[i] << "\n";
+						}
+						chunks[k] = out.str();
+						});
+				for (const auto &chunk:chunks) {
+					nodeOutFile << chunk;
 				}
-				nodeInFile.close();
 				nodeOutFile.close();
 
 			}
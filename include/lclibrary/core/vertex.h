@@ -26,16 +26,14 @@
 #include <lclibrary/core/vec2d.h>
 
 #include <iostream>
-#include <list>
 
 namespace lclibrary {
 
 	class Edge;
-	typedef std::list <const Edge *> AdjacentEdgeList;
 
+	/*! The adjacency of vertices is stored in Graph, see Graph::GetOutEdges() */
 	class Vertex {
 		size_t id_; /*! Actual node ID of the Vertex */
-		AdjacentEdgeList adjacent_edges_list_; /*! Stores adjacent vertices of the Vertex */
 		double lla_[3]; /*! Latitude, longitude, altitude */
 		Vec2d xy_; /*! XY coordinate */
 
@@ -46,7 +44,7 @@ namespace lclibrary {
 
 		Vertex() : Vertex(0) {}
 
-		/*! Copy constructor (does not copy adjacency list)*/
+		/*! Copy constructor */
 		Vertex(const Vertex &v){
 			CopyDataFromVertex(v);
 		}
@@ -82,39 +80,6 @@ namespace lclibrary {
 			}
 		}
 
-		/*! Adds adjacent edge/arc */
-		void AddEdge(const Edge *e) {
-			adjacent_edges_list_.push_back(e);
-		}
-
-		/*! Clears adjacent edge list */
-		void ClearAdjacentList(){
-			adjacent_edges_list_.clear();
-		}
-
-		AdjacentEdgeList::const_iterator GetAdjacencyStart() const{
-			return adjacent_edges_list_.cbegin();
-		}
-
-		bool IsAdjacencyEnd(const AdjacentEdgeList::const_iterator it) const {
-			if (it == adjacent_edges_list_.cend())
-				return kFail;
-			else
-				return kSuccess;
-		}
-
-		bool GetAdjacentEdge(const Edge *&e, const AdjacentEdgeList::const_iterator it) const {
-			if(it == adjacent_edges_list_.end()) {
-				e = nullptr;
-				return kFail;
-			}
-			e = *it;
-			return kSuccess;
-		}
-
-		/*! Returns size of adjacent list */
-		size_t GetAdjListSize() const{ return adjacent_edges_list_.size(); }
-
 		size_t GetID() const { return id_; }
 
 		void SetID(const size_t a){ id_ = a; }
@@ -37,6 +37,7 @@ namespace lclibrary {
 		std::vector <std::shared_ptr <Graph>> sol_digraph_list_;
 		std::vector <Route> route_list_;
 		bool use_2opt_ = true;
+		APSP_Options apsp_options_;
 
 		public:
 		MLC_Base(const std::shared_ptr <const Graph> g_in) : g_{g_in} {};
@@ -61,6 +62,10 @@ namespace lclibrary {
 			use_2opt_ = use;
 		}
 
+		virtual void SetAPSPOptions(const APSP_Options &options) {
+			apsp_options_ = options;
+		}
+
 		void Gnuplot(const std::string data_file_name, const std::string gnuplot_file_name, const std::string output_plot_file_name, bool plot_non_required) const {
 			if(sol_digraph_list_.empty()) {
 				std::cerr << "MLC not solved\n";
@@ -183,6 +188,20 @@ namespace lclibrary {
 
 		virtual double GetObjBound() {return 0;}
 
+		/* Bytes held by the solver, by part. The input graph is not counted; solution graphs count only the vertices they do not share with it. */
+		virtual void GetMemoryFootprint(MemoryFootprintList &list) const {
+			size_t route_bytes = VectorBytes(route_list_);
+			for(const auto &route:route_list_) {
+				route_bytes += route.MemoryFootprint();
+			}
+			size_t sol_digraph_bytes = VectorBytes(sol_digraph_list_);
+			for(const auto &sol_digraph:sol_digraph_list_) {
+				sol_digraph_bytes += sol_digraph->MemoryFootprint(false);
+			}
+			list.emplace_back("routes", route_bytes);
+			list.emplace_back("solution_graphs", sol_digraph_bytes);
+		}
+
 	};
 
 }
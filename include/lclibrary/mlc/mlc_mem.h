@@ -40,14 +40,11 @@ namespace lclibrary {
 		size_t n_, m_;
 		size_t v0;
 		std::vector <MEM_Route*> mem_route_list_;
-		std::shared_ptr <APSP_FloydWarshall> apsp_;
+		std::shared_ptr <APSP> apsp_;
 		double capacity_ = 0;
 
 		public:
-		MLC_MEM(const std::shared_ptr <const Graph> g_in) : MEM_Base(), MLC_Base(g_in) {
-			apsp_ = std::make_shared <APSP_FloydWarshall>(g_, true);
-			apsp_->APSP_Deadheading();
-		}
+		MLC_MEM(const std::shared_ptr <const Graph> g_in) : MEM_Base(), MLC_Base(g_in) { }
 
 		~MLC_MEM() {
 			mem_route_list_.clear();
@@ -58,6 +55,8 @@ namespace lclibrary {
 				std::cerr << "MEM error: Depot is not set\n";
 				return kFail;
 			}
+			apsp_ = CreateAPSP(g_, true, apsp_options_);
+			apsp_->APSP_Deadheading();
 			n_ = g_->GetN();
 			m_ = g_->GetM();
 
@@ -376,13 +375,6 @@ namespace lclibrary {
 		}
 
 		void GenerateRoutes() {
-			std::vector <Vertex> vertex_list;
-			for(size_t i = 0; i < n_; ++i) {
-				Vertex v;
-				g_->GetVertexData(i, v);
-				vertex_list.push_back(v);
-			}
-
 			for(const auto &r:mem_route_list_) {
 				if(r == nullptr)
 					continue;
@@ -395,7 +387,7 @@ namespace lclibrary {
 				GetPath(edge_list, r);
 				apsp_->GetPath(edge_list, h, v0);
 
-				auto sol_digraph = std::make_shared <Graph>(vertex_list, edge_list);
+				auto sol_digraph = std::make_shared <Graph>(*g_, edge_list);
 				sol_digraph_list_.push_back(sol_digraph);
 			}
 		}
@@ -437,6 +429,14 @@ namespace lclibrary {
 			delete r;
 		}
 
+		/* mem_routes is the largest number of MEM routes held during the merges */
+		void GetMemoryFootprint(MemoryFootprintList &list) const {
+			MLC_Base::GetMemoryFootprint(list);
+			list.emplace_back("apsp", apsp_ == nullptr ? 0 : apsp_->MemoryFootprint());
+			list.emplace_back("mem_routes", VectorBytes(mem_route_list_) + mem_route_list_.size() * sizeof(MEM_Route));
+			list.emplace_back("mem_savings_peak", GetSavingsPeakBytes());
+		}
+
 	};
 
 }
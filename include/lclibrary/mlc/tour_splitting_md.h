@@ -49,20 +49,17 @@ namespace lclibrary {
 	class MLC_TS_MD : public MLC_Base {
 		private:
 			size_t n_, m_, K_;
-			APSP_FloydWarshall *apsp_;
+			std::shared_ptr <APSP> apsp_;
 			double capacity_ = 0;
 			std::vector <size_t> depots_;
 			std::vector <Edge> req_edges_;
 			std::vector < std::vector <Sequence>> sequence_;
 			std::vector < std::vector <std::vector<Tour>>> tours_;
 			Route route_;
-			std::vector <Vertex> vertex_list_;
 
 		public:
 			MLC_TS_MD(const std::shared_ptr <const Graph> g_in) : MLC_Base(g_in) {
 				std::cout << "Start MLC TS MD\n";
-				apsp_ = new APSP_FloydWarshall(g_, true);
-				apsp_->APSP_Deadheading();
 				n_ = g_->GetN();
 				m_ = g_->GetM();
 				capacity_ = g_->GetCapacity();
@@ -79,19 +76,16 @@ namespace lclibrary {
 			}
 
 			~MLC_TS_MD() {
-				delete apsp_;
 			}
 
 			int Solve() {
-				for(size_t i = 0; i < n_; ++i) {
-					Vertex v;
-					g_->GetVertexData(i, v);
-					vertex_list_.push_back(v);
-				}
+				apsp_ = CreateAPSP(g_, true, apsp_options_);
+				apsp_->APSP_Deadheading();
 				std::cout << "Solve MLC TS MD\n";
 				SLC_Beta2ATSP slc_beta2_atsp(g_);
 				bool use_2opt = true;
 				slc_beta2_atsp.Use2Opt(use_2opt);
+				slc_beta2_atsp.SetAPSPOptions(apsp_options_);
 				std::cout << std::boolalpha;
 				slc_beta2_atsp.Solve();
 				std::cout << "beta2_atsp Solution check: " << slc_beta2_atsp.CheckSolution() << std::endl;
@@ -303,7 +297,7 @@ namespace lclibrary {
 					final_edges.push_back(e);
 					curr_e = e;
 				}
-				auto sol_digraph = std::make_shared <Graph> (vertex_list_, final_edges);
+				auto sol_digraph = std::make_shared <Graph> (*g_, final_edges);
 				sol_digraph->SetDepot(t.depot_);
 				sol_digraph->PrintNM();
 				sol_digraph_list_.push_back(sol_digraph);
@@ -444,6 +438,26 @@ namespace lclibrary {
 				g_->GetVertexIndex(hID, hindex);
 				apsp_->GetPath(edge_list, tindex, hindex);
 			}
+
+			/* sequences and tours hold m x m and m x m x K entries */
+			void GetMemoryFootprint(MemoryFootprintList &list) const {
+				MLC_Base::GetMemoryFootprint(list);
+				list.emplace_back("apsp", apsp_ == nullptr ? 0 : apsp_->MemoryFootprint());
+				size_t sequence_bytes = VectorBytes(sequence_);
+				for(const auto &row:sequence_) {
+					sequence_bytes += VectorBytes(row);
+				}
+				size_t tour_bytes = VectorBytes(tours_);
+				for(const auto &row:tours_) {
+					tour_bytes += VectorBytes(row);
+					for(const auto &entry:row) {
+						tour_bytes += VectorBytes(entry);
+					}
+				}
+				list.emplace_back("sequences", sequence_bytes);
+				list.emplace_back("tours", tour_bytes);
+				list.emplace_back("route", route_.MemoryFootprint() + VectorBytes(req_edges_));
+			}
 	};
 }
 
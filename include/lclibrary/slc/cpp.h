@@ -34,17 +34,17 @@
 namespace lclibrary {
 
 	class SLC_CPP : public SLC_Base{
-		std::shared_ptr <APSP_FloydWarshall> apsp_;
+		std::shared_ptr <APSP> apsp_;
 		std::vector <int> vertex_degree_list_;
 
 		public:
 		SLC_CPP(std::shared_ptr <const Graph> g_in) : SLC_Base (g_in){
-			apsp_ = std::make_shared<APSP_FloydWarshall>(g_);
-			apsp_->APSP_Deadheading();
 			sol_digraph_ = std::make_shared <Graph> (*g_);
 		}
 
 		int Solve() {
+			apsp_ = CreateAPSP(g_, false, apsp_options_);
+			apsp_->APSP_Deadheading();
 			ComputeVertexDegree(g_, vertex_degree_list_);
 			size_t num_odd_vertices = std::count_if (vertex_degree_list_.begin(), vertex_degree_list_.end(), [](int i) {return ((i%2) == 1);});
 			if(num_odd_vertices > 0) {
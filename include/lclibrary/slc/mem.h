@@ -40,19 +40,18 @@ namespace lclibrary {
 		size_t n_, m_;
 		size_t v0;
 		std::vector <MEM_Route*> route_list_;
-		std::shared_ptr <APSP_FloydWarshall> apsp_;
+		std::shared_ptr <APSP> apsp_;
 
 		public:
-		SLC_MEM(std::shared_ptr <const Graph> g_in) : MEM_Base(), SLC_Base(g_in) {
-			apsp_ = std::make_shared <APSP_FloydWarshall>(g_);
-			apsp_->APSP_Deadheading();
-		}
+		SLC_MEM(std::shared_ptr <const Graph> g_in) : MEM_Base(), SLC_Base(g_in) { }
 
 		~SLC_MEM() {
 			route_list_.clear();
 		}
 
 		int Solve() {
+			apsp_ = CreateAPSP(g_, false, apsp_options_);
+			apsp_->APSP_Deadheading();
 			n_ = g_->GetN();
 			m_ = g_->GetM();
 			InitializeRoutes();
@@ -253,12 +252,6 @@ namespace lclibrary {
 		}
 
 		void GenerateRoute() {
-			std::vector <Vertex> vertex_list;
-			for(size_t i = 0; i < n_; ++i) {
-				Vertex v;
-				g_->GetVertexData(i, v);
-				vertex_list.push_back(v);
-			}
 			std::vector <Edge> edge_list;
 			auto r = route_list_.back();
 			size_t t, h;
@@ -267,7 +260,7 @@ namespace lclibrary {
 			apsp_->GetPath(edge_list, v0, t);
 			GetPath(edge_list, r);
 			apsp_->GetPath(edge_list, h, v0);
-			sol_digraph_ = std::make_shared <Graph>(vertex_list, edge_list);
+			sol_digraph_ = std::make_shared <Graph>(*g_, edge_list);
 		}
 
 		void GetPath(std::vector <Edge> &edge_list, MEM_Route* r) {
@@ -307,6 +300,14 @@ namespace lclibrary {
 			delete r;
 		}
 
+		/* mem_routes is the largest number of MEM routes held during the merges */
+		void GetMemoryFootprint(MemoryFootprintList &list) const {
+			SLC_Base::GetMemoryFootprint(list);
+			list.emplace_back("apsp", apsp_ == nullptr ? 0 : apsp_->MemoryFootprint());
+			list.emplace_back("mem_routes", VectorBytes(route_list_) + route_list_.size() * sizeof(MEM_Route));
+			list.emplace_back("mem_savings_peak", GetSavingsPeakBytes());
+		}
+
 	};
 
 }
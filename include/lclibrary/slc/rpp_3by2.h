@@ -48,13 +48,13 @@ namespace lclibrary {
 
 		std::shared_ptr <Graph> mst_;
 		std::shared_ptr <Graph> g_r_;
-		std::shared_ptr <APSP_FloydWarshall> apsp_;
+		std::shared_ptr <APSP> apsp_;
 		std::shared_ptr <ConnectedComponents> cc_;
 		size_t num_cc_;
 		std::vector <int> vertex_degree_list_;
 		std::vector<std::vector<MSTEdge>> edges_;
 
-		void GenerateMSTGraph() {
+		int GenerateMSTGraph() {
 			edges_.resize(num_cc_, std::vector<MSTEdge>(num_cc_));
 			for(size_t i = 0; i < g_r_->GetN(); ++i) {
 				auto u = cc_->GetVertexCC(i);
@@ -83,30 +83,28 @@ namespace lclibrary {
 					edge_list.push_back(e);
 				}
 			}
-			mst_ = std::make_shared<Graph>(vertex_list, edge_list);
+			GraphBuilder graph_builder(std::move(vertex_list), std::move(edge_list));
+			return graph_builder.Build(mst_);
 		}
 
 		public:
 		SLC_RPP(const std::shared_ptr <const Graph> &g_in) : SLC_Base (g_in) {
-			apsp_ = std::make_shared <APSP_FloydWarshall>(g_);
-			apsp_->APSP_Deadheading();
-			std::vector <Vertex> vertex_list;
-			for(size_t i = 0; i < g_->GetN(); ++i) {
-				Vertex v;
-				g_->GetVertexData(i, v);
-				vertex_list.push_back(v);
-			}
 			std::vector <Edge> edge_list;
+			edge_list.reserve(g_->GetM());
 			for(size_t i = 0; i < g_->GetM(); ++i) {
 				Edge e;
 				g_->GetEdgeData(i, e, kIsRequired);
 				edge_list.push_back(e);
 			}
-			sol_digraph_ = std::make_shared <Graph>(vertex_list, edge_list, edge_list.size(), 0);
+			sol_digraph_ = std::make_shared <Graph>(*g_, edge_list);
 		}
 
 		int Solve() {
-			GenerateRequiredGraph(g_, g_r_);
+			apsp_ = CreateAPSP(g_, false, apsp_options_);
+			apsp_->APSP_Deadheading();
+			if(GenerateRequiredGraph(g_, g_r_) == kFail) {
+				return kFail;
+			}
 			g_r_->AddReverseEdges();
 
 			cc_ = std::make_shared <ConnectedComponents>(g_r_);
@@ -115,7 +113,9 @@ namespace lclibrary {
 			std::vector <Edge> mst_edges;
 			std::vector <Edge> mst_edge_list;
 			if(num_cc_ != 1) {
-				GenerateMSTGraph();
+				if(GenerateMSTGraph() == kFail) {
+					return kFail;
+				}
 				MST_Prim(mst_, mst_edges);
 				for(const auto &e:mst_edges) {
 					size_t t, h;
@@ -41,6 +41,7 @@ namespace lclibrary {
 		std::shared_ptr <Graph> sol_digraph_;
 		Route route_;
 		bool use_2opt_ = true;
+		APSP_Options apsp_options_;
 
 		public:
 		SLC_Base(const std::shared_ptr <const Graph> &g_in) : g_{g_in} {};
@@ -59,6 +60,10 @@ namespace lclibrary {
 			use_2opt_ = use;
 		}
 
+		virtual void SetAPSPOptions(const APSP_Options &options) {
+			apsp_options_ = options;
+		}
+
 		void Gnuplot(
 				const std::string data_file_name,
 				const std::string gnuplot_file_name,
@@ -111,6 +116,12 @@ namespace lclibrary {
 		virtual void GetComputationTimes(std::vector <double> &comp_t) {}
 		virtual void GetCosts(std::vector <double> &costs) {}
 
+		/* Bytes held by the solver, by part. The input graph is not counted; the solution graph counts only the vertices it does not share with it. */
+		virtual void GetMemoryFootprint(MemoryFootprintList &list) const {
+			list.emplace_back("route", route_.MemoryFootprint());
+			list.emplace_back("solution_graph", sol_digraph_ == nullptr ? 0 : sol_digraph_->MemoryFootprint(false));
+		}
+
 		int RouteOutput (const Config &config) const {
 			std::string sol_dir = config.sol_dir;
 			if(not std::filesystem::exists(sol_dir)) {
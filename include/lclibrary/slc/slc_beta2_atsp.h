@@ -45,7 +45,7 @@ namespace lclibrary {
 
 		std::shared_ptr <Graph> undirected_graph_;
 		std::unique_ptr <SLC_LP> lp_;
-		std::shared_ptr <APSP_FloydWarshall> apsp_;
+		std::shared_ptr <APSP> apsp_;
 		std::unique_ptr <ConnectedComponents> cc_;
 		std::vector <size_t> atsp_tour_;
 		double time_lp_, time_beta2_, time_atsp_, time_2opt_;
@@ -64,7 +64,7 @@ namespace lclibrary {
 #else
 			lp_ = std::make_unique <SLC_LP_glpk> (g_);
 #endif
-			apsp_ = std::make_shared <APSP_FloydWarshall>(g_);
+			apsp_ = CreateAPSP(g_, false, apsp_options_);
 			lp_->Solve();
 			lp_->GenerateSolutionGraph(sol_digraph_, undirected_graph_);
 			auto t_end_lp = std::chrono::high_resolution_clock::now();
@@ -215,6 +215,12 @@ namespace lclibrary {
 			}
 			sol_digraph_->AddEdge(edge_list);
 		}
+
+		void GetMemoryFootprint(MemoryFootprintList &list) const {
+			SLC_Base::GetMemoryFootprint(list);
+			list.emplace_back("apsp", apsp_ == nullptr ? 0 : apsp_->MemoryFootprint());
+			list.emplace_back("undirected_graph", undirected_graph_ == nullptr ? 0 : undirected_graph_->MemoryFootprint(false));
+		}
 	};
 
 }
@@ -43,7 +43,7 @@ namespace lclibrary {
 	class SLC_Beta2GTSP : public SLC_Base{
 		std::shared_ptr <Graph> undirected_graph_;
 		std::unique_ptr <SLC_LP> lp_;
-		std::shared_ptr <APSP_FloydWarshall> apsp_;
+		std::shared_ptr <APSP> apsp_;
 		std::unique_ptr <ConnectedComponents> cc_;
 		std::vector <size_t> gtsp_tour_;
 		double time_lp_, time_beta2_, time_gtsp_, time_2opt_;
@@ -62,7 +62,7 @@ namespace lclibrary {
 #else
 			lp_ = std::make_unique <SLC_LP_glpk> (g_);
 #endif
-			apsp_ = std::make_shared <APSP_FloydWarshall>(g_);
+			apsp_ = CreateAPSP(g_, false, apsp_options_);
 			lp_->Solve();
 			lp_->GenerateSolutionGraph(sol_digraph_, undirected_graph_);
 			auto t_end_lp = std::chrono::high_resolution_clock::now();
@@ -1,6 +1,6 @@
 /**
  * This file is part of the LineCoverage-library.
- * The file contains functions to generate adjacency list of graph
+ * Allocator for std::vector buffers aligned to cache lines
  *
  * TODO:
  *
@@ -21,31 +21,43 @@
  * You should have received a copy of the GNU General Public License along with LineCoverage-library. If not, see <https://www.gnu.org/licenses/>.
  */
 
-#include <lclibrary/core/graph.h>
+#ifndef LCLIBRARY_UTILS_ALIGNED_ALLOCATOR_H_
+#define LCLIBRARY_UTILS_ALIGNED_ALLOCATOR_H_
+
+#include <cstddef>
+#include <new>
+#include <vector>
 
 namespace lclibrary {
 
-	int Graph::AdjacencyListGeneration() {
-		for (auto &v:vertex_list_) {
-			v->ClearAdjacentList();
-		}
-		for(auto const &e:required_edge_list_) {
-			Vertex *v1, *v2;
-			if(GetVertex(e->GetTailVertexID(), v1) or GetVertex(e->GetHeadVertexID(), v2)) {
-				std::cerr << "Edge list error" << std::endl;
-				return kFail;
+	template <typename T, size_t kAlignment = 64>
+		struct AlignedAllocator {
+			typedef T value_type;
+
+			template <typename U>
+				struct rebind { typedef AlignedAllocator <U, kAlignment> other; };
+
+			AlignedAllocator() noexcept {}
+			template <typename U>
+				AlignedAllocator(const AlignedAllocator <U, kAlignment> &) noexcept {}
+
+			T *allocate(const size_t n) {
+				return static_cast <T *> (::operator new(n * sizeof(T), std::align_val_t(kAlignment)));
 			}
-			v1->AddEdge(e);
-		}
-		for(auto const &e:non_required_edge_list_) {
-			Vertex *v1, *v2;
-			if(GetVertex(e->GetTailVertexID(), v1) or GetVertex(e->GetHeadVertexID(), v2)) {
-				std::cerr << "Edge list error" << std::endl;
-				return kFail;
+
+			void deallocate(T *p, const size_t) noexcept {
+				::operator delete(p, std::align_val_t(kAlignment));
 			}
-			v1->AddEdge(e);
-		}
-		return kSuccess;
-	}
+
+			template <typename U>
+				bool operator == (const AlignedAllocator <U, kAlignment> &) const noexcept { return true; }
+			template <typename U>
+				bool operator != (const AlignedAllocator <U, kAlignment> &) const noexcept { return false; }
+		};
+
+	template <typename T>
+		using AlignedVector = std::vector <T, AlignedAllocator <T>>;
 
 } // namespace lclibrary
+
+#endif /* LCLIBRARY_UTILS_ALIGNED_ALLOCATOR_H_ */
@@ -29,49 +29,195 @@
 #include <lclibrary/core/transform_lla_xy.h>
 #include <lclibrary/core/graph_io.h>
 #include <lclibrary/core/graph_utilities.h>
+#include <lclibrary/utils/mapped_file.h>
+#include <charconv>
 #include <exception>
 #include <fstream>
 #include <iostream>
 #include <filesystem>
+#include <string>
+#include <vector>
 #include <json/json.hpp>
 
 namespace lclibrary {
 
 	using json = nlohmann::json;
-	inline void OSMjsonGraph(const std::string &osm_filename, const std::string &node_filename, const std::string &edge_filename) {
-		std::ifstream osm_file(osm_filename);
-		std::ofstream node_file(node_filename);
-		std::ofstream edge_file(edge_filename);
-		json osm_data;
-		osm_file >> osm_data;
-		std::cout << osm_data["osm3s"]["copyright"] << std::endl;
-		json elements = osm_data["elements"];
-		for(auto &e:elements) {
-			if(e["type"] == "node") {
-				node_file << e["id"] << " " << e["lat"] << " " << e["lon"] << std::endl;
-			}
-			else if(e["type"] == "way") {
-				json nodes = e["nodes"];
-				size_t node_prev = nodes[0];
-				bool start_flag = false;
-				for(auto &n:nodes) {
-					if(start_flag == false) {
-						start_flag = true;
-						continue;
-					}
-					edge_file << node_prev << " " << n << std::endl;
-					node_prev = n;
+
+	/* SAX handler for Overpass JSON. Each element of the elements array is held until its object ends, then a node is written as "id lat lon" and a way as one "tail head" line per segment. Peak memory is one element, independent of the size of the input. Numbers are written as the DOM parser would print them. */
+	class OSMjsonSAX : public nlohmann::json_sax <json> {
+		std::ofstream &node_file_;
+		std::ofstream &edge_file_;
+		/* Depth 1 is the root object, 2 the elements array or the osm3s object, 3 an element */
+		size_t depth_ = 0;
+		std::string key_;
+		bool in_elements_ = false;
+		bool in_osm3s_ = false;
+		bool in_nodes_ = false;
+
+		std::string type_;
+		std::string id_, lat_, lon_;
+		std::vector <number_unsigned_t> nodes_;
+		char line_[128];
+
+		void ClearElement() {
+			type_.clear(); id_.clear(); lat_.clear(); lon_.clear();
+			nodes_.clear();
+		}
+
+		void WriteElement() {
+			if(type_ == "node") {
+				node_file_ << id_ << " " << lat_ << " " << lon_ << "\n";
+			}
+			else if(type_ == "way") {
+				for(size_t i = 1; i < nodes_.size(); ++i) {
+					char *end = std::to_chars(line_, line_ + sizeof(line_), nodes_[i - 1]).ptr;
+					*end++ = ' ';
+					end = std::to_chars(end, line_ + sizeof(line_), nodes_[i]).ptr;
+					*end++ = '\n';
+					edge_file_.write(line_, end - line_);
 				}
 			}
 			else {
-				std::cout << "Unhandled element type: " << e["type"] << std::endl;
+				std::cout << "Unhandled element type: " << json(type_) << std::endl;
 			}
 		}
 
-		osm_file.close();
+		/* Value of a field of the current element; nested values such as tags are skipped */
+		std::string *ElementField() {
+			if(not in_elements_ or depth_ != 3) {
+				return nullptr;
+			}
+			if(key_ == "id") { return &id_; }
+			if(key_ == "lat") { return &lat_; }
+			if(key_ == "lon") { return &lon_; }
+			return nullptr;
+		}
+
+		template <typename T>
+			bool Number(const T val) {
+				if(in_nodes_ and depth_ == 4) {
+					nodes_.push_back(number_unsigned_t(val));
+				}
+				else if(std::string *field = ElementField()) {
+					*field = std::to_string(val);
+				}
+				return true;
+			}
+
+		public:
+		OSMjsonSAX(std::ofstream &node_file, std::ofstream &edge_file) : node_file_{node_file}, edge_file_{edge_file} {}
+
+		bool null() override { return true; }
+		bool boolean(bool) override { return true; }
+		bool number_integer(number_integer_t val) override { return Number(val); }
+		bool number_unsigned(number_unsigned_t val) override { return Number(val); }
+
+		bool number_float(number_float_t val, const string_t &) override {
+			if(std::string *field = ElementField()) {
+				/* The bundled json.hpp formats floats for dump() with detail::to_chars */
+				char buffer[64];
+				char *end = nlohmann::detail::to_chars(buffer, buffer + sizeof(buffer), val);
+				field->assign(buffer, end);
+			}
+			return true;
+		}
+
+		bool string(string_t &val) override {
+			if(in_elements_ and depth_ == 3 and key_ == "type") {
+				type_ = val;
+			}
+			if(in_osm3s_ and depth_ == 2 and key_ == "copyright") {
+				std::cout << json(val) << std::endl;
+			}
+			return true;
+		}
+
+		bool binary(binary_t &) override { return true; }
+
+		bool start_object(std::size_t) override {
+			++depth_;
+			if(depth_ == 2 and key_ == "osm3s") {
+				in_osm3s_ = true;
+			}
+			if(in_elements_ and depth_ == 3) {
+				ClearElement();
+			}
+			return true;
+		}
+
+		bool end_object() override {
+			if(in_elements_ and depth_ == 3) {
+				WriteElement();
+			}
+			if(depth_ == 2) {
+				in_osm3s_ = false;
+			}
+			--depth_;
+			return true;
+		}
+
+		bool start_array(std::size_t) override {
+			++depth_;
+			if(depth_ == 2 and key_ == "elements") {
+				in_elements_ = true;
+			}
+			if(in_elements_ and depth_ == 4 and key_ == "nodes") {
+				in_nodes_ = true;
+			}
+			return true;
+		}
+
+		bool end_array() override {
+			if(depth_ == 2) {
+				in_elements_ = false;
+			}
+			if(depth_ == 4) {
+				in_nodes_ = false;
+			}
+			--depth_;
+			return true;
+		}
+
+		bool key(string_t &val) override {
+			if(depth_ <= 3) {
+				key_ = val;
+			}
+			return true;
+		}
+
+		bool parse_error(std::size_t position, const std::string &, const nlohmann::detail::exception &ex) override {
+			std::cerr << "OSM JSON parse error at byte " << position << ": " << ex.what() << std::endl;
+			return false;
+		}
+	};
+
+	/* The file is mapped into memory and parsed as a stream, so no DOM of the input is built */
+	inline int OSMjsonGraph(const std::string &osm_filename, const std::string &node_filename, const std::string &edge_filename) {
+		MappedFile osm_file;
+		if(osm_file.Open(osm_filename) == kFail) {
+			std::cerr << "Cannot open " << osm_filename << std::endl;
+			return kFail;
+		}
+		std::ofstream node_file(node_filename);
+		std::ofstream edge_file(edge_filename);
+		if(not node_file or not edge_file) {
+			std::cerr << "Cannot open " << node_filename << " or " << edge_filename << std::endl;
+			return kFail;
+		}
+		OSMjsonSAX sax(node_file, edge_file);
+		const char *data = osm_file.GetData();
+		if(not json::sax_parse(data, data + osm_file.GetSize(), &sax)) {
+			return kFail;
+		}
 		node_file.close();
 		edge_file.close();
+		if(not node_file or not edge_file) {
+			std::cerr << "Could not write " << node_filename << " or " << edge_filename << std::endl;
+			return kFail;
+		}
+		return kSuccess;
 	}
+
 	inline int OSMjsonGraph(const Config &config) {
 		auto fn = config.filenames;
 		auto dir = config.database.path + "/" + config.database.data_dir + "/";
@@ -79,17 +225,42 @@ namespace lclibrary {
 			std::cerr << "JSON file " << dir + fn.map_json << " does not exist\n";
 			return 1;
 		}
-		OSMjsonGraph(dir + fn.map_json, dir + fn.nodes_ll, dir + fn.req_edges);
+		if(OSMjsonGraph(dir + fn.map_json, dir + fn.nodes_ll, dir + fn.req_edges) == kFail) {
+			std::cerr << "OSM JSON conversion failed\n";
+			return 1;
+		}
 		LLAtoXY llaToXY(dir + fn.nodes_ll, dir + fn.nodes_data);
 		std::shared_ptr <lclibrary::Graph> G;
 		lclibrary::CreateGraph(G, dir + fn.nodes_data, dir + fn.req_edges, lclibrary::kIsWithLLA, not lclibrary::kIsWithCost, true);
 		G->ShiftOrigin();
+		if(config.simplify_chains) {
+			/* The depots are set when the graph is read back, so the configured ones must survive the contraction */
+			std::vector <size_t> depot_IDs;
+			if((config.problem == "slc" or config.problem == "mlc") and config.depot_mode == Config::DepotMode::custom) {
+				depot_IDs.push_back(config.depot_ID);
+			}
+			/* The mean depot is chosen among all the vertices, so it may be a shape vertex */
+			if((config.problem == "slc" or config.problem == "mlc") and config.depot_mode == Config::DepotMode::mean) {
+				depot_IDs.push_back(G->GetMeanDepotID());
+			}
+			if(config.problem == "mlc_md" and config.depots_mode == Config::DepotsMode::user) {
+				depot_IDs.insert(depot_IDs.end(), config.depot_IDs.begin(), config.depot_IDs.end());
+			}
+			if(ContractShapeVertices(G, depot_IDs) == kFail) {
+				return 1;
+			}
+			WriteRequiredEdges(G, dir + fn.req_edges, not lclibrary::kIsWithCost);
+			WriteEdgeShapes(G, dir + fn.edge_shapes);
+		}
 		WriteNodes(G, dir + fn.nodes_data, lclibrary::kIsWithLLA);
 		if(config.add_pairwise_nonreq_edges) {
 			/* AddCompleteNonRequiredEdges(G); */
 			AddReducedCompleteNonRequiredEdges(G);
 			WriteNonRequiredEdges(G, dir + fn.nonreq_edges);
 		}
+		if(not fn.graph_binary.empty()) {
+			WriteGraphBinary(G, dir + fn.graph_binary);
+		}
 
 		std::string info_filename = dir + "/" + config.database.data_dir + ".info";
 		WriteGraphInfo(G, info_filename);
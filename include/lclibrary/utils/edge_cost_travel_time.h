@@ -49,10 +49,7 @@ namespace lclibrary {
 			e.GetVertices(t, h);
 			if(t == nullptr or h == nullptr)
 				return 1;
-			auto t_xy = t->GetXY();
-			auto h_xy = h->GetXY();
-			cost = ComputeTravelTime(t_xy, h_xy, service_speed_);
-			cost_rev = ComputeTravelTime(h_xy, t_xy, service_speed_);
+			ComputePolylineTravelTime(e, service_speed_, cost, cost_rev);
 			return 0;
 
 		}
@@ -62,14 +59,22 @@ namespace lclibrary {
 			e.GetVertices(t, h);
 			if(t == nullptr or h == nullptr)
 				return 1;
-			auto t_xy = t->GetXY();
-			auto h_xy = h->GetXY();
-			cost = ComputeTravelTime(t_xy, h_xy, deadheading_speed_);
-			cost_rev = ComputeTravelTime(h_xy, t_xy, deadheading_speed_);
+			ComputePolylineTravelTime(e, deadheading_speed_, cost, cost_rev);
 			return 0;
 
 		}
 
+		/*! Sum of the travel times of the segments between the shape points of the edge */
+		void ComputePolylineTravelTime(const Edge &e, const double vel, double &cost, double &cost_rev) const {
+			cost = 0; cost_rev = 0;
+			for(size_t k = 1; k < e.GetNumPolylinePoints(); ++k) {
+				auto t_xy = e.GetPolylinePoint(k - 1).GetXY();
+				auto h_xy = e.GetPolylinePoint(k).GetXY();
+				cost += ComputeTravelTime(t_xy, h_xy, vel);
+				cost_rev += ComputeTravelTime(h_xy, t_xy, vel);
+			}
+		}
+
 		double ComputeTravelTime(const Vec2d t_xy, const Vec2d h_xy, const double vel) const {
 			double d, tht;
 			t_xy.DistTht(h_xy, d, tht);
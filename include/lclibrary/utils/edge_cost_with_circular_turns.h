@@ -76,14 +76,9 @@ namespace lclibrary {
 			Vec2d e1_t, e1_h;
 			Vec2d e2_t, e2_h;
 			/* std::cout << "Inside ComputeTurnCost\n"; */
-			e1->GetTailVertexXY(e1_t); e1->GetHeadVertexXY(e1_h);
-			e2->GetTailVertexXY(e2_t); e2->GetHeadVertexXY(e2_h);
-			if(rev1) {
-				std::swap(e1_t, e1_h);
-			}
-			if(rev2) {
-				std::swap(e2_t, e2_h);
-			}
+			/* The turn is between the last segment of e1 and the first segment of e2 */
+			e1->GetLastSegmentXY(e1_t, e1_h, rev1);
+			e2->GetFirstSegmentXY(e2_t, e2_h, rev2);
 			double init_vel1 = service_speed_;
 			double init_vel2 = service_speed_;
 			if(!serv1) {
@@ -119,10 +114,7 @@ namespace lclibrary {
 			e.GetVertices(t, h);
 			if(t == nullptr or h == nullptr)
 				return 1;
-			auto t_xy = t->GetXY();
-			auto h_xy = h->GetXY();
-			cost = ComputeTravelTime(t_xy, h_xy, service_speed_);
-			cost_rev = ComputeTravelTime(h_xy, t_xy, service_speed_);
+			ComputePolylineTravelTime(e, service_speed_, cost, cost_rev);
 			return 0;
 
 		}
@@ -132,14 +124,36 @@ namespace lclibrary {
 			e.GetVertices(t, h);
 			if(t == nullptr or h == nullptr)
 				return 1;
-			auto t_xy = t->GetXY();
-			auto h_xy = h->GetXY();
-			cost = ComputeTravelTime(t_xy, h_xy, deadheading_speed_);
-			cost_rev = ComputeTravelTime(h_xy, t_xy, deadheading_speed_);
+			ComputePolylineTravelTime(e, deadheading_speed_, cost, cost_rev);
 			return 0;
 
 		}
 
+		/*! Sum of the travel times of the segments between the shape points of the edge and of the turns at its shape points, so that an edge with shape points costs the same as the chain of edges it replaced */
+		void ComputePolylineTravelTime(const Edge &e, const double vel, double &cost, double &cost_rev) const {
+			cost = 0; cost_rev = 0;
+			const size_t num_points = e.GetNumPolylinePoints();
+			for(size_t k = 1; k < num_points; ++k) {
+				auto t_xy = e.GetPolylinePoint(k - 1).GetXY();
+				auto h_xy = e.GetPolylinePoint(k).GetXY();
+				cost += ComputeTravelTime(t_xy, h_xy, vel);
+				cost_rev += ComputeTravelTime(h_xy, t_xy, vel);
+			}
+			CircularTurn circ_turn;
+			for(size_t k = 1; k + 1 < num_points; ++k) {
+				auto p0 = e.GetPolylinePoint(k - 1).GetXY();
+				auto p1 = e.GetPolylinePoint(k).GetXY();
+				auto p2 = e.GetPolylinePoint(k + 1).GetXY();
+				double turn_cost;
+				if(ComputeSegmentTurnCost(p0, p1, p1, p2, vel, vel, turn_cost, circ_turn) == kSuccess) {
+					cost += turn_cost;
+				}
+				if(ComputeSegmentTurnCost(p2, p1, p1, p0, vel, vel, turn_cost, circ_turn) == kSuccess) {
+					cost_rev += turn_cost;
+				}
+			}
+		}
+
 		double ComputeTravelTime(const Vec2d t_xy, const Vec2d h_xy, const double vel) const {
 			double d, tht;
 			t_xy.DistTht(h_xy, d, tht);
@@ -164,22 +178,14 @@ namespace lclibrary {
 			Vec2d e1_t, e1_h;
 			Vec2d e2_t, e2_h;
 			/* std::cout << "Inside ComputeTurnCost\n"; */
-			e1->GetTailVertexXY(e1_t); e1->GetHeadVertexXY(e1_h);
-			e2->GetTailVertexXY(e2_t); e2->GetHeadVertexXY(e2_h);
-			if(rev1) {
-				std::swap(e1_t, e1_h);
-			}
-			if(rev2) {
-				std::swap(e2_t, e2_h);
-			}
-			double init_vel1 = service_speed_;
-			double init_vel2 = service_speed_;
-			if(!serv1) {
-				init_vel1 = deadheading_speed_;
-			}
-			if(!serv2) {
-				init_vel2 = deadheading_speed_;
-			}
+			/* The turn is between the last segment of e1 and the first segment of e2 */
+			e1->GetLastSegmentXY(e1_t, e1_h, rev1);
+			e2->GetFirstSegmentXY(e2_t, e2_h, rev2);
+			return ComputeSegmentTurnCost(e1_t, e1_h, e2_t, e2_h, GetSpeed(serv1), GetSpeed(serv2), cost, circ_turn);
+		}
+
+		/*! Turn from the segment e1_t e1_h to the segment e2_t e2_h, entered and left at the speeds init_vel1 and init_vel2 */
+		int ComputeSegmentTurnCost(Vec2d e1_t, Vec2d e1_h, Vec2d e2_t, Vec2d e2_h, const double init_vel1, const double init_vel2, double &cost, CircularTurn &circ_turn) const {
 			double vel = std::min(init_vel1, init_vel2);
 
 			if(std::abs(e1_h.x - e2_t.x) > kEps or std::abs(e1_h.y - e2_t.y) > kEps) {
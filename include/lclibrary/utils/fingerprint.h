@@ -0,0 +1,89 @@
+/**
+ * This file is part of the LineCoverage-library.
+ * 64-bit FNV-1a fingerprint of data used to key cached results
+ *
+ * TODO:
+ *
+ * @author Saurav Agarwal
+ * @contact sagarw10@uncc.edu
+ * @contact agr.saurav1@gmail.com
+ * Repository: https://github.com/UNCCharlotte-Robotics/LineCoverage-library
+ *
+ * Copyright (C) 2020--2022 University of North Carolina at Charlotte.
+ * The LineCoverage-library is owned by the University of North Carolina at Charlotte and is protected by United States copyright laws and applicable international treaties and/or conventions.
+ *
+ * The LineCoverage-library is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * DISCLAIMER OF WARRANTIES: THE SOFTWARE IS PROVIDED "AS-IS" WITHOUT WARRANTY OF ANY KIND INCLUDING ANY WARRANTIES OF PERFORMANCE OR MERCHANTABILITY OR FITNESS FOR A PARTICULAR USE OR PURPOSE OR OF NON-INFRINGEMENT. YOU BEAR ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE SOFTWARE OR HARDWARE.
+ *
+ * SUPPORT AND MAINTENANCE: No support, installation, or training is provided.
+ *
+ * You should have received a copy of the GNU General Public License along with LineCoverage-library. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LCLIBRARY_UTILS_FINGERPRINT_H_
+#define LCLIBRARY_UTILS_FINGERPRINT_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace lclibrary {
+
+	class Fingerprint {
+		uint64_t hash_ = 14695981039346656037ULL;
+
+		public:
+		void Add(const void *data, const size_t num_bytes) {
+			const unsigned char *bytes = static_cast <const unsigned char *> (data);
+			for(size_t i = 0; i < num_bytes; ++i) {
+				hash_ ^= bytes[i];
+				hash_ *= 1099511628211ULL;
+			}
+		}
+
+		template <typename T>
+			void Add(const T value) {
+				static_assert(std::is_arithmetic<T>::value, "Fingerprint::Add expects an arithmetic type");
+				Add(&value, sizeof(T));
+			}
+
+		void Add(const std::string &str) {
+			Add(str.size());
+			Add(str.data(), str.size());
+		}
+
+		uint64_t Get() const {
+			return hash_;
+		}
+	};
+
+	/* Checksum of a buffer that reads eight bytes at a time in four independent lanes, for large files where the byte-wise Fingerprint is too slow. seed chains the checksums of several buffers. */
+	inline uint64_t Checksum(const void *data, const size_t num_bytes, const uint64_t seed = 0) {
+		constexpr uint64_t kPrime1 = 11400714785074694791ULL;
+		constexpr uint64_t kPrime2 = 14029467366897019727ULL;
+		auto rotl = [](const uint64_t x, const int r) { return (x << r) | (x >> (64 - r)); };
+		const unsigned char *bytes = static_cast <const unsigned char *> (data);
+		uint64_t lanes[4] = {seed + kPrime1 + kPrime2, seed + kPrime2, seed, seed - kPrime1};
+		size_t i = 0;
+		for(; i + 32 <= num_bytes; i += 32) {
+			for(size_t k = 0; k < 4; ++k) {
+				uint64_t word;
+				std::memcpy(&word, bytes + i + 8 * k, sizeof(uint64_t));
+				lanes[k] = rotl(lanes[k] + word * kPrime2, 31) * kPrime1;
+			}
+		}
+		uint64_t hash = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18) + num_bytes;
+		for(; i < num_bytes; ++i) {
+			hash = rotl((hash ^ bytes[i]) * kPrime1, 11);
+		}
+		hash ^= hash >> 33;
+		hash *= kPrime2;
+		hash ^= hash >> 29;
+		return hash;
+	}
+
+} // namespace lclibrary
+
+#endif /* LCLIBRARY_UTILS_FINGERPRINT_H_ */
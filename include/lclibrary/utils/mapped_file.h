@@ -0,0 +1,98 @@
+/**
+ * This file is part of the LineCoverage-library.
+ * Read-only memory mapped file
+ *
+ * TODO:
+ *
+ * @author Saurav Agarwal
+ * @contact sagarw10@uncc.edu
+ * @contact agr.saurav1@gmail.com
+ * Repository: https://github.com/UNCCharlotte-Robotics/LineCoverage-library
+ *
+ * Copyright (C) 2020--2022 University of North Carolina at Charlotte.
+ * The LineCoverage-library is owned by the University of North Carolina at Charlotte and is protected by United States copyright laws and applicable international treaties and/or conventions.
+ *
+ * The LineCoverage-library is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * DISCLAIMER OF WARRANTIES: THE SOFTWARE IS PROVIDED "AS-IS" WITHOUT WARRANTY OF ANY KIND INCLUDING ANY WARRANTIES OF PERFORMANCE OR MERCHANTABILITY OR FITNESS FOR A PARTICULAR USE OR PURPOSE OR OF NON-INFRINGEMENT. YOU BEAR ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE SOFTWARE OR HARDWARE.
+ *
+ * SUPPORT AND MAINTENANCE: No support, installation, or training is provided.
+ *
+ * You should have received a copy of the GNU General Public License along with LineCoverage-library. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LCLIBRARY_UTILS_MAPPED_FILE_H_
+#define LCLIBRARY_UTILS_MAPPED_FILE_H_
+
+#include <lclibrary/core/constants.h>
+#include <string>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace lclibrary {
+
+	class MappedFile {
+		void *data_ = nullptr;
+		size_t size_ = 0;
+
+		public:
+		MappedFile() {}
+		MappedFile(const MappedFile &) = delete;
+		MappedFile &operator=(const MappedFile &) = delete;
+
+		~MappedFile() {
+			Close();
+		}
+
+		/* Returns kFail if the file cannot be opened or mapped; an empty file maps to size 0 */
+		bool Open(const std::string &filename) {
+			Close();
+			int fd = open(filename.c_str(), O_RDONLY);
+			if(fd < 0) {
+				return kFail;
+			}
+			struct stat file_stat;
+			if(fstat(fd, &file_stat) != 0) {
+				close(fd);
+				return kFail;
+			}
+			size_ = file_stat.st_size;
+			if(size_ == 0) {
+				close(fd);
+				return kSuccess;
+			}
+			data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+			close(fd);
+			if(data_ == MAP_FAILED) {
+				data_ = nullptr;
+				size_ = 0;
+				std::cerr << "Could not map file " << filename << std::endl;
+				return kFail;
+			}
+			madvise(data_, size_, MADV_WILLNEED);
+			return kSuccess;
+		}
+
+		void Close() {
+			if(data_ != nullptr) {
+				munmap(data_, size_);
+			}
+			data_ = nullptr;
+			size_ = 0;
+		}
+
+		const char *GetData() const {
+			return static_cast <const char *> (data_);
+		}
+
+		size_t GetSize() const {
+			return size_;
+		}
+	};
+
+} // namespace lclibrary
+
+#endif /* LCLIBRARY_UTILS_MAPPED_FILE_H_ */
@@ -0,0 +1,140 @@
+/**
+ * This file is part of the LineCoverage-library.
+ * The file contains helpers to estimate the memory held by data structures and to track the peak memory of the process
+ *
+ * TODO:
+ *
+ * @author Saurav Agarwal
+ * @contact sagarw10@uncc.edu
+ * @contact agr.saurav1@gmail.com
+ * Repository: https://github.com/UNCCharlotte-Robotics/LineCoverage-library
+ *
+ * Copyright (C) 2020--2022 University of North Carolina at Charlotte.
+ * The LineCoverage-library is owned by the University of North Carolina at Charlotte and is protected by United States copyright laws and applicable international treaties and/or conventions.
+ *
+ * The LineCoverage-library is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * DISCLAIMER OF WARRANTIES: THE SOFTWARE IS PROVIDED "AS-IS" WITHOUT WARRANTY OF ANY KIND INCLUDING ANY WARRANTIES OF PERFORMANCE OR MERCHANTABILITY OR FITNESS FOR A PARTICULAR USE OR PURPOSE OR OF NON-INFRINGEMENT. YOU BEAR ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE SOFTWARE OR HARDWARE.
+ *
+ * SUPPORT AND MAINTENANCE: No support, installation, or training is provided.
+ *
+ * You should have received a copy of the GNU General Public License along with LineCoverage-library. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LCLIBRARY_UTILS_MEMORY_FOOTPRINT_H_
+#define LCLIBRARY_UTILS_MEMORY_FOOTPRINT_H_
+
+#include <lclibrary/core/constants.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <sys/resource.h>
+
+namespace lclibrary {
+
+	/*! Parts of a solver and the bytes each holds, in the order they were added */
+	typedef std::vector <std::pair <std::string, size_t>> MemoryFootprintList;
+
+	inline size_t SumMemoryFootprint(const MemoryFootprintList &list) {
+		size_t bytes = 0;
+		for(const auto &part:list) {
+			bytes += part.second;
+		}
+		return bytes;
+	}
+
+	/* The estimates count the allocated capacity of the containers, not the allocator overhead */
+	template <typename T, typename Alloc>
+		inline size_t VectorBytes(const std::vector <T, Alloc> &v) {
+			return v.capacity() * sizeof(T);
+		}
+
+	template <typename T, typename Alloc>
+		inline size_t ListBytes(const std::list <T, Alloc> &l) {
+			return l.size() * (sizeof(T) + 2 * sizeof(void *));
+		}
+
+	template <typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+		inline size_t HashMapBytes(const std::unordered_map <Key, T, Hash, KeyEqual, Alloc> &map) {
+			return map.bucket_count() * sizeof(void *) + map.size() * (sizeof(std::pair <const Key, T>) + 2 * sizeof(void *));
+		}
+
+	/*! Peak resident set size of the process in bytes: VmHWM of /proc/self/status, or getrusage() where /proc is not available */
+	inline size_t GetPeakResidentBytes() {
+		std::ifstream status_file("/proc/self/status");
+		std::string key;
+		while(status_file >> key) {
+			if(key == "VmHWM:") {
+				size_t kb;
+				status_file >> kb;
+				return kb << 10;
+			}
+			status_file.ignore(std::numeric_limits <std::streamsize>::max(), '\n');
+		}
+		struct rusage usage;
+		if(getrusage(RUSAGE_SELF, &usage) != 0) {
+			return 0;
+		}
+#ifdef __APPLE__
+		return usage.ru_maxrss;
+#else
+		return size_t(usage.ru_maxrss) << 10;
+#endif
+	}
+
+	/*! Resets the peak resident set size of the process to the current one. Only Linux supports this; kFail is returned elsewhere. */
+	inline bool ResetPeakResidentBytes() {
+		std::ofstream clear_refs_file("/proc/self/clear_refs");
+		if(not clear_refs_file) {
+			return kFail;
+		}
+		clear_refs_file << "5";
+		clear_refs_file.flush();
+		return clear_refs_file.good() ? kSuccess : kFail;
+	}
+
+	/*! Peak resident set size of each stage of a run, e.g. graph creation and solving. The peak of a stage includes the memory still held from earlier stages. Where the peak cannot be reset, it is the peak since the start of the process. */
+	class StageMemoryTracker {
+		MemoryFootprintList stages_;
+		std::string stage_;
+
+		public:
+		void StartStage(const std::string &name) {
+			stage_ = name;
+			ResetPeakResidentBytes();
+		}
+
+		void EndStage() {
+			stages_.emplace_back(stage_, GetPeakResidentBytes());
+		}
+
+		const MemoryFootprintList & GetStages() const { return stages_; }
+
+		size_t GetPeak() const {
+			size_t peak = 0;
+			for(const auto &stage:stages_) {
+				peak = std::max(peak, stage.second);
+			}
+			return peak;
+		}
+	};
+
+	inline void PrintMemoryFootprint(const std::string &name, const MemoryFootprintList &list) {
+		std::cout << name << " memory (MB):";
+		for(const auto &part:list) {
+			std::cout << " " << part.first << " " << (part.second >> 20);
+		}
+		std::cout << std::endl;
+	}
+
+} // namespace lclibrary
+
+#endif /* LCLIBRARY_UTILS_MEMORY_FOOTPRINT_H_ */
@@ -0,0 +1,183 @@
+/**
+ * This file is part of the LineCoverage-library.
+ * The file contains the min-plus row kernels of Floyd-Warshall with AVX2 and AVX-512 versions selected at runtime
+ *
+ * TODO:
+ *
+ * @author Saurav Agarwal
+ * @contact sagarw10@uncc.edu
+ * @contact agr.saurav1@gmail.com
+ * Repository: https://github.com/UNCCharlotte-Robotics/LineCoverage-library
+ *
+ * Copyright (C) 2020--2022 University of North Carolina at Charlotte.
+ * The LineCoverage-library is owned by the University of North Carolina at Charlotte and is protected by United States copyright laws and applicable international treaties and/or conventions.
+ *
+ * The LineCoverage-library is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * DISCLAIMER OF WARRANTIES: THE SOFTWARE IS PROVIDED "AS-IS" WITHOUT WARRANTY OF ANY KIND INCLUDING ANY WARRANTIES OF PERFORMANCE OR MERCHANTABILITY OR FITNESS FOR A PARTICULAR USE OR PURPOSE OR OF NON-INFRINGEMENT. YOU BEAR ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE SOFTWARE OR HARDWARE.
+ *
+ * SUPPORT AND MAINTENANCE: No support, installation, or training is provided.
+ *
+ * You should have received a copy of the GNU General Public License along with LineCoverage-library. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LCLIBRARY_UTILS_MIN_PLUS_H_
+#define LCLIBRARY_UTILS_MIN_PLUS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define LCLIBRARY_MIN_PLUS_X86
+#include <immintrin.h>
+#endif
+
+namespace lclibrary {
+
+	/* For j in [0, count): if d_ik + d_k[j] < d_i[j], set d_i[j] to the sum, s_i[j] to s_ik and, when q_i is not null, q_i[j] to q_ik + q_k[j]. The vector kernels evaluate the same sums and comparisons as the scalar loop, so the results are identical. */
+	template <typename CostType>
+		using MinPlusRowFn = void (*)(const CostType d_ik, const CostType *d_k, CostType *d_i, const uint32_t s_ik, uint32_t *s_i, const CostType q_ik, const CostType *q_k, CostType *q_i, const size_t count);
+
+	template <typename CostType, bool with_demand>
+		void MinPlusRowScalar(const CostType d_ik, const CostType *d_k, CostType *d_i, const uint32_t s_ik, uint32_t *s_i, const CostType q_ik, const CostType *q_k, CostType *q_i, const size_t count) {
+			for(size_t j = 0; j < count; ++j) {
+				if(d_ik + d_k[j] < d_i[j]) {
+					d_i[j] = d_ik + d_k[j];
+					s_i[j] = s_ik;
+					if(with_demand) {
+						q_i[j] = q_ik + q_k[j];
+					}
+				}
+			}
+		}
+
+#ifdef LCLIBRARY_MIN_PLUS_X86
+
+	template <bool with_demand>
+		__attribute__((target("avx2"))) void MinPlusRowAVX2(const double d_ik, const double *d_k, double *d_i, const uint32_t s_ik, uint32_t *s_i, const double q_ik, const double *q_k, double *q_i, const size_t count) {
+			const __m256d d_ik_v = _mm256_set1_pd(d_ik);
+			const __m256d q_ik_v = _mm256_set1_pd(q_ik);
+			const __m128i s_ik_v = _mm_set1_epi32(int(s_ik));
+			/* Selects the low 32 bits of each 64-bit mask lane */
+			const __m256i low_halves = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+			size_t j = 0;
+			for(; j + 4 <= count; j += 4) {
+				const __m256d sum = _mm256_add_pd(d_ik_v, _mm256_loadu_pd(d_k + j));
+				const __m256d d_i_v = _mm256_loadu_pd(d_i + j);
+				const __m256d mask = _mm256_cmp_pd(sum, d_i_v, _CMP_LT_OQ);
+				if(_mm256_movemask_pd(mask) == 0) {
+					continue;
+				}
+				_mm256_storeu_pd(d_i + j, _mm256_blendv_pd(d_i_v, sum, mask));
+				const __m128i mask32 = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(_mm256_castpd_si256(mask), low_halves));
+				_mm_maskstore_epi32(reinterpret_cast <int *> (s_i + j), mask32, s_ik_v);
+				if(with_demand) {
+					const __m256d q_sum = _mm256_add_pd(q_ik_v, _mm256_loadu_pd(q_k + j));
+					_mm256_storeu_pd(q_i + j, _mm256_blendv_pd(_mm256_loadu_pd(q_i + j), q_sum, mask));
+				}
+			}
+			MinPlusRowScalar<double, with_demand>(d_ik, d_k + j, d_i + j, s_ik, s_i + j, q_ik, with_demand ? q_k + j : q_k, with_demand ? q_i + j : q_i, count - j);
+		}
+
+	template <bool with_demand>
+		__attribute__((target("avx2"))) void MinPlusRowAVX2(const float d_ik, const float *d_k, float *d_i, const uint32_t s_ik, uint32_t *s_i, const float q_ik, const float *q_k, float *q_i, const size_t count) {
+			const __m256 d_ik_v = _mm256_set1_ps(d_ik);
+			const __m256 q_ik_v = _mm256_set1_ps(q_ik);
+			const __m256i s_ik_v = _mm256_set1_epi32(int(s_ik));
+			size_t j = 0;
+			for(; j + 8 <= count; j += 8) {
+				const __m256 sum = _mm256_add_ps(d_ik_v, _mm256_loadu_ps(d_k + j));
+				const __m256 d_i_v = _mm256_loadu_ps(d_i + j);
+				const __m256 mask = _mm256_cmp_ps(sum, d_i_v, _CMP_LT_OQ);
+				if(_mm256_movemask_ps(mask) == 0) {
+					continue;
+				}
+				_mm256_storeu_ps(d_i + j, _mm256_blendv_ps(d_i_v, sum, mask));
+				_mm256_maskstore_epi32(reinterpret_cast <int *> (s_i + j), _mm256_castps_si256(mask), s_ik_v);
+				if(with_demand) {
+					const __m256 q_sum = _mm256_add_ps(q_ik_v, _mm256_loadu_ps(q_k + j));
+					_mm256_storeu_ps(q_i + j, _mm256_blendv_ps(_mm256_loadu_ps(q_i + j), q_sum, mask));
+				}
+			}
+			MinPlusRowScalar<float, with_demand>(d_ik, d_k + j, d_i + j, s_ik, s_i + j, q_ik, with_demand ? q_k + j : q_k, with_demand ? q_i + j : q_i, count - j);
+		}
+
+	template <bool with_demand>
+		__attribute__((target("avx512f"))) void MinPlusRowAVX512(const double d_ik, const double *d_k, double *d_i, const uint32_t s_ik, uint32_t *s_i, const double q_ik, const double *q_k, double *q_i, const size_t count) {
+			const __m512d d_ik_v = _mm512_set1_pd(d_ik);
+			const __m512d q_ik_v = _mm512_set1_pd(q_ik);
+			const __m512i s_ik_v = _mm512_set1_epi32(int(s_ik));
+			size_t j = 0;
+			for(; j + 8 <= count; j += 8) {
+				const __m512d sum = _mm512_add_pd(d_ik_v, _mm512_loadu_pd(d_k + j));
+				const __mmask8 mask = _mm512_cmp_pd_mask(sum, _mm512_loadu_pd(d_i + j), _CMP_LT_OQ);
+				if(mask == 0) {
+					continue;
+				}
+				_mm512_mask_storeu_pd(d_i + j, mask, sum);
+				/* Only the low eight 32-bit lanes can be selected */
+				_mm512_mask_storeu_epi32(s_i + j, __mmask16(mask), s_ik_v);
+				if(with_demand) {
+					_mm512_mask_storeu_pd(q_i + j, mask, _mm512_add_pd(q_ik_v, _mm512_loadu_pd(q_k + j)));
+				}
+			}
+			MinPlusRowScalar<double, with_demand>(d_ik, d_k + j, d_i + j, s_ik, s_i + j, q_ik, with_demand ? q_k + j : q_k, with_demand ? q_i + j : q_i, count - j);
+		}
+
+	template <bool with_demand>
+		__attribute__((target("avx512f"))) void MinPlusRowAVX512(const float d_ik, const float *d_k, float *d_i, const uint32_t s_ik, uint32_t *s_i, const float q_ik, const float *q_k, float *q_i, const size_t count) {
+			const __m512 d_ik_v = _mm512_set1_ps(d_ik);
+			const __m512 q_ik_v = _mm512_set1_ps(q_ik);
+			const __m512i s_ik_v = _mm512_set1_epi32(int(s_ik));
+			size_t j = 0;
+			for(; j + 16 <= count; j += 16) {
+				const __m512 sum = _mm512_add_ps(d_ik_v, _mm512_loadu_ps(d_k + j));
+				const __mmask16 mask = _mm512_cmp_ps_mask(sum, _mm512_loadu_ps(d_i + j), _CMP_LT_OQ);
+				if(mask == 0) {
+					continue;
+				}
+				_mm512_mask_storeu_ps(d_i + j, mask, sum);
+				_mm512_mask_storeu_epi32(s_i + j, mask, s_ik_v);
+				if(with_demand) {
+					_mm512_mask_storeu_ps(q_i + j, mask, _mm512_add_ps(q_ik_v, _mm512_loadu_ps(q_k + j)));
+				}
+			}
+			MinPlusRowScalar<float, with_demand>(d_ik, d_k + j, d_i + j, s_ik, s_i + j, q_ik, with_demand ? q_k + j : q_k, with_demand ? q_i + j : q_i, count - j);
+		}
+
+#endif /* LCLIBRARY_MIN_PLUS_X86 */
+
+	/* Name of the widest kernel the CPU supports: "avx512", "avx2" or "scalar" */
+	inline std::string GetMinPlusKernelName() {
+#ifdef LCLIBRARY_MIN_PLUS_X86
+		__builtin_cpu_init();
+		if(__builtin_cpu_supports("avx512f")) {
+			return "avx512";
+		}
+		if(__builtin_cpu_supports("avx2")) {
+			return "avx2";
+		}
+#endif
+		return "scalar";
+	}
+
+	template <typename CostType, bool with_demand>
+		MinPlusRowFn <CostType> GetMinPlusRow() {
+			static_assert(std::is_same <CostType, double>::value or std::is_same <CostType, float>::value, "Min-plus kernels are for float and double");
+#ifdef LCLIBRARY_MIN_PLUS_X86
+			static const std::string kernel = GetMinPlusKernelName();
+			if(kernel == "avx512") {
+				return &MinPlusRowAVX512<with_demand>;
+			}
+			if(kernel == "avx2") {
+				return &MinPlusRowAVX2<with_demand>;
+			}
+#endif
+			return &MinPlusRowScalar<CostType, with_demand>;
+		}
+
+} // namespace lclibrary
+
+#endif /* LCLIBRARY_UTILS_MIN_PLUS_H_ */
@@ -0,0 +1,110 @@
+/**
+ * This file is part of the LineCoverage-library.
+ * The file contains a block arena that allocates objects of one type contiguously
+ *
+ * TODO:
+ *
+ * @author Saurav Agarwal
+ * @contact sagarw10@uncc.edu
+ * @contact agr.saurav1@gmail.com
+ * Repository: https://github.com/UNCCharlotte-Robotics/LineCoverage-library
+ *
+ * Copyright (C) 2020--2022 University of North Carolina at Charlotte.
+ * The LineCoverage-library is owned by the University of North Carolina at Charlotte and is protected by United States copyright laws and applicable international treaties and/or conventions.
+ *
+ * The LineCoverage-library is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * DISCLAIMER OF WARRANTIES: THE SOFTWARE IS PROVIDED "AS-IS" WITHOUT WARRANTY OF ANY KIND INCLUDING ANY WARRANTIES OF PERFORMANCE OR MERCHANTABILITY OR FITNESS FOR A PARTICULAR USE OR PURPOSE OR OF NON-INFRINGEMENT. YOU BEAR ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE SOFTWARE OR HARDWARE.
+ *
+ * SUPPORT AND MAINTENANCE: No support, installation, or training is provided.
+ *
+ * You should have received a copy of the GNU General Public License along with LineCoverage-library. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LCLIBRARY_UTILS_OBJECT_ARENA_H_
+#define LCLIBRARY_UTILS_OBJECT_ARENA_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace lclibrary {
+
+	/* Objects are constructed in large blocks in the order of creation, so scans over them access memory sequentially. Objects are never moved; they are destroyed together by Clear() or the destructor. */
+	template <typename T>
+		class ObjectArena {
+			static constexpr size_t kMinBlockSize = 256;
+
+			struct Block {
+				T *data_;
+				size_t size_;
+				size_t capacity_;
+			};
+
+			std::vector <Block> blocks_;
+			std::allocator <T> allocator_;
+			size_t num_objects_ = 0;
+
+			void AddBlock(const size_t capacity) {
+				blocks_.push_back(Block{std::allocator_traits <std::allocator <T>>::allocate(allocator_, capacity), 0, capacity});
+			}
+
+			public:
+			ObjectArena() {}
+			ObjectArena(const ObjectArena &) = delete;
+			ObjectArena & operator = (const ObjectArena &) = delete;
+
+			~ObjectArena() {
+				Clear();
+			}
+
+			/* The next n objects are placed in one block */
+			void Reserve(const size_t n) {
+				if(blocks_.empty() or blocks_.back().capacity_ - blocks_.back().size_ < n) {
+					AddBlock(std::max(n, kMinBlockSize));
+				}
+			}
+
+			template <typename... Args>
+				T * Create(Args &&... args) {
+					if(blocks_.empty() or blocks_.back().size_ == blocks_.back().capacity_) {
+						AddBlock(blocks_.empty() ? kMinBlockSize : 2 * blocks_.back().capacity_);
+					}
+					Block &block = blocks_.back();
+					T *object = block.data_ + block.size_;
+					std::allocator_traits <std::allocator <T>>::construct(allocator_, object, std::forward <Args>(args)...);
+					++block.size_;
+					++num_objects_;
+					return object;
+				}
+
+			void Clear() {
+				for(auto &block:blocks_) {
+					for(size_t i = 0; i < block.size_; ++i) {
+						std::allocator_traits <std::allocator <T>>::destroy(allocator_, block.data_ + i);
+					}
+					std::allocator_traits <std::allocator <T>>::deallocate(allocator_, block.data_, block.capacity_);
+				}
+				blocks_.clear();
+				num_objects_ = 0;
+			}
+
+			size_t GetNumObjects() const {
+				return num_objects_;
+			}
+
+			/* Bytes allocated for the blocks, including unused capacity */
+			size_t GetMemoryBytes() const {
+				size_t bytes = blocks_.capacity() * sizeof(Block);
+				for(const auto &block:blocks_) {
+					bytes += block.capacity_ * sizeof(T);
+				}
+				return bytes;
+			}
+		};
+
+} // namespace lclibrary
+
+#endif /* LCLIBRARY_UTILS_OBJECT_ARENA_H_ */
@@ -0,0 +1,185 @@
+/**
+ * This file is part of the LineCoverage-library.
+ * Parser for records of whitespace separated numbers in a memory mapped text file
+ *
+ * TODO:
+ *
+ * @author Saurav Agarwal
+ * @contact sagarw10@uncc.edu
+ * @contact agr.saurav1@gmail.com
+ * Repository: https://github.com/UNCCharlotte-Robotics/LineCoverage-library
+ *
+ * Copyright (C) 2020--2022 University of North Carolina at Charlotte.
+ * The LineCoverage-library is owned by the University of North Carolina at Charlotte and is protected by United States copyright laws and applicable international treaties and/or conventions.
+ *
+ * The LineCoverage-library is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * DISCLAIMER OF WARRANTIES: THE SOFTWARE IS PROVIDED "AS-IS" WITHOUT WARRANTY OF ANY KIND INCLUDING ANY WARRANTIES OF PERFORMANCE OR MERCHANTABILITY OR FITNESS FOR A PARTICULAR USE OR PURPOSE OR OF NON-INFRINGEMENT. YOU BEAR ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE SOFTWARE OR HARDWARE.
+ *
+ * SUPPORT AND MAINTENANCE: No support, installation, or training is provided.
+ *
+ * You should have received a copy of the GNU General Public License along with LineCoverage-library. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LCLIBRARY_UTILS_TEXT_RECORD_PARSER_H_
+#define LCLIBRARY_UTILS_TEXT_RECORD_PARSER_H_
+
+#include <lclibrary/core/constants.h>
+#include <lclibrary/utils/mapped_file.h>
+#include <lclibrary/utils/thread_pool.h>
+#include <algorithm>
+#include <charconv>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace lclibrary {
+
+	/* Records of num_columns whitespace separated numbers, e.g. the node data and edge lists. Columns in id_columns are parsed as size_t, the others as double. As when the file is read with ifstream >>, parsing stops at the first token that is not a number and a trailing incomplete record is ignored; line breaks are not significant. Large files are split into chunks that are parsed in parallel. */
+	class TextRecordParser {
+		static constexpr size_t kMinChunkBytes = size_t(1) << 20;
+
+		size_t num_columns_;
+		std::vector <bool> is_id_column_;
+		std::vector <size_t> column_offset_; /* Position of a column among the id or the real columns */
+		size_t num_id_columns_ = 0;
+		size_t num_real_columns_ = 0;
+		size_t num_records_ = 0;
+		std::vector <size_t> ids_; /* Row-major, num_id_columns_ per record */
+		std::vector <double> reals_; /* Row-major, num_real_columns_ per record */
+
+		static inline bool IsSpace(const char c) {
+			return c == ' ' or c == '\n' or c == '\t' or c == '\r' or c == '\v' or c == '\f';
+		}
+
+		static size_t CountTokens(const char *begin, const char *end) {
+			size_t num_tokens = 0;
+			bool in_token = false;
+			for(const char *c = begin; c != end; ++c) {
+				bool is_space = IsSpace(*c);
+				num_tokens += (not is_space and not in_token);
+				in_token = not is_space;
+			}
+			return num_tokens;
+		}
+
+		/* Parses the tokens in [begin, end), the first of which has index first_token in the file. Returns the index of the first token that is not a number, or kNIL. */
+		size_t ParseTokens(const char *begin, const char *end, const size_t first_token) {
+			const size_t num_tokens = num_records_ * num_columns_;
+			size_t token = first_token;
+			const char *c = begin;
+			while(token < num_tokens) {
+				while(c != end and IsSpace(*c)) {
+					++c;
+				}
+				if(c == end) {
+					break;
+				}
+				const char *token_end = c;
+				while(token_end != end and not IsSpace(*token_end)) {
+					++token_end;
+				}
+				/* ifstream accepts a leading plus sign, std::from_chars does not */
+				const char *number = (*c == '+') ? c + 1 : c;
+				const size_t record = token / num_columns_;
+				const size_t column = token % num_columns_;
+				std::from_chars_result result;
+				if(is_id_column_[column]) {
+					result = std::from_chars(number, token_end, ids_[record * num_id_columns_ + column_offset_[column]]);
+				} else {
+					result = std::from_chars(number, token_end, reals_[record * num_real_columns_ + column_offset_[column]]);
+				}
+				if(result.ec != std::errc() or result.ptr != token_end) {
+					return token;
+				}
+				c = token_end;
+				++token;
+			}
+			return kNIL;
+		}
+
+		public:
+		TextRecordParser(const size_t num_columns, const std::vector <size_t> &id_columns) : num_columns_{num_columns}, is_id_column_(num_columns, false), column_offset_(num_columns) {
+			for(const auto &column:id_columns) {
+				is_id_column_[column] = true;
+			}
+			for(size_t column = 0; column < num_columns_; ++column) {
+				column_offset_[column] = is_id_column_[column] ? num_id_columns_++ : num_real_columns_++;
+			}
+		}
+
+		/* Returns kFail if the file cannot be opened */
+		bool Parse(const std::string &filename, const size_t num_threads = 0) {
+			MappedFile file;
+			if(file.Open(filename) == kFail) {
+				std::cerr << "Cannot open " << filename << std::endl;
+				return kFail;
+			}
+			const char *data = file.GetData();
+			const size_t size = file.GetSize();
+
+			/* Chunks end at whitespace so that no token is split */
+			size_t num_chunks = std::max(size_t(1), std::min(GetNumThreads(num_threads), size / kMinChunkBytes));
+			std::vector <size_t> chunk_begin(num_chunks + 1, size);
+			chunk_begin[0] = 0;
+			for(size_t k = 1; k < num_chunks; ++k) {
+				size_t position = std::max(chunk_begin[k - 1], size / num_chunks * k);
+				while(position < size and not IsSpace(data[position])) {
+					++position;
+				}
+				chunk_begin[k] = position;
+			}
+
+			std::unique_ptr <ThreadPool> pool;
+			if(num_chunks > 1) {
+				pool = std::make_unique <ThreadPool> (num_chunks);
+			}
+			auto parallel_for = [&](const std::function <void(size_t)> &fn) {
+				if(pool == nullptr) {
+					fn(0);
+				} else {
+					pool->ParallelFor(0, num_chunks, fn);
+				}
+			};
+
+			std::vector <size_t> first_token(num_chunks + 1, 0);
+			parallel_for([&](const size_t k) {
+					first_token[k + 1] = CountTokens(data + chunk_begin[k], data + chunk_begin[k + 1]);
+					});
+			for(size_t k = 0; k < num_chunks; ++k) {
+				first_token[k + 1] += first_token[k];
+			}
+
+			num_records_ = first_token[num_chunks] / num_columns_;
+			ids_.assign(num_records_ * num_id_columns_, 0);
+			reals_.assign(num_records_ * num_real_columns_, 0);
+			std::vector <size_t> first_error(num_chunks, kNIL);
+			parallel_for([&](const size_t k) {
+					first_error[k] = ParseTokens(data + chunk_begin[k], data + chunk_begin[k + 1], first_token[k]);
+					});
+			const size_t error_token = *std::min_element(first_error.begin(), first_error.end());
+			if(error_token != kNIL) {
+				num_records_ = error_token / num_columns_;
+				ids_.resize(num_records_ * num_id_columns_);
+				reals_.resize(num_records_ * num_real_columns_);
+			}
+			return kSuccess;
+		}
+
+		size_t GetNumRecords() const { return num_records_; }
+
+		size_t GetID(const size_t record, const size_t column) const {
+			return ids_[record * num_id_columns_ + column_offset_[column]];
+		}
+
+		double GetReal(const size_t record, const size_t column) const {
+			return reals_[record * num_real_columns_ + column_offset_[column]];
+		}
+	};
+
+} // namespace lclibrary
+
+#endif /* LCLIBRARY_UTILS_TEXT_RECORD_PARSER_H_ */
@@ -0,0 +1,142 @@
+/**
+ * This file is part of the LineCoverage-library.
+ * A simple pool of worker threads for data parallel loops
+ *
+ * TODO: Support nested calls to ParallelFor from within a task
+ *
+ * @author Saurav Agarwal
+ * @contact sagarw10@uncc.edu
+ * @contact agr.saurav1@gmail.com
+ * Repository: https://github.com/UNCCharlotte-Robotics/LineCoverage-library
+ *
+ * Copyright (C) 2020--2022 University of North Carolina at Charlotte.
+ * The LineCoverage-library is owned by the University of North Carolina at Charlotte and is protected by United States copyright laws and applicable international treaties and/or conventions.
+ *
+ * The LineCoverage-library is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * DISCLAIMER OF WARRANTIES: THE SOFTWARE IS PROVIDED "AS-IS" WITHOUT WARRANTY OF ANY KIND INCLUDING ANY WARRANTIES OF PERFORMANCE OR MERCHANTABILITY OR FITNESS FOR A PARTICULAR USE OR PURPOSE OR OF NON-INFRINGEMENT. YOU BEAR ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE SOFTWARE OR HARDWARE.
+ *
+ * SUPPORT AND MAINTENANCE: No support, installation, or training is provided.
+ *
+ * You should have received a copy of the GNU General Public License along with LineCoverage-library. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LCLIBRARY_UTILS_THREAD_POOL_H_
+#define LCLIBRARY_UTILS_THREAD_POOL_H_
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+namespace lclibrary {
+
+	/* Returns the number of threads to use; 0 requests all hardware threads */
+	inline size_t GetNumThreads(const size_t num_threads) {
+		if(num_threads != 0) {
+			return num_threads;
+		}
+		size_t hardware_threads = std::thread::hardware_concurrency();
+		return hardware_threads == 0 ? 1 : hardware_threads;
+	}
+
+	class ThreadPool {
+		std::vector <std::thread> workers_;
+		std::mutex mutex_;
+		std::condition_variable start_cv_;
+		std::condition_variable done_cv_;
+		const std::function <void(size_t)> *task_ = nullptr;
+		std::atomic <size_t> next_index_{0};
+		size_t end_index_ = 0;
+		size_t generation_ = 0;
+		size_t num_active_ = 0;
+		bool stop_ = false;
+
+		void RunTask() {
+			size_t i;
+			while((i = next_index_.fetch_add(1)) < end_index_) {
+				(*task_)(i);
+			}
+		}
+
+		void Worker() {
+			size_t generation = 0;
+			while(true) {
+				{
+					std::unique_lock <std::mutex> lock(mutex_);
+					start_cv_.wait(lock, [&] { return stop_ or generation_ != generation; });
+					if(stop_) {
+						return;
+					}
+					generation = generation_;
+				}
+				RunTask();
+				{
+					std::lock_guard <std::mutex> lock(mutex_);
+					if(--num_active_ == 0) {
+						done_cv_.notify_one();
+					}
+				}
+			}
+		}
+
+		public:
+		ThreadPool(const size_t num_threads = 0) {
+			size_t total_threads = lclibrary::GetNumThreads(num_threads);
+			for(size_t i = 1; i < total_threads; ++i) {
+				workers_.emplace_back(&ThreadPool::Worker, this);
+			}
+		}
+
+		ThreadPool(const ThreadPool &) = delete;
+		ThreadPool &operator=(const ThreadPool &) = delete;
+
+		~ThreadPool() {
+			{
+				std::lock_guard <std::mutex> lock(mutex_);
+				stop_ = true;
+			}
+			start_cv_.notify_all();
+			for(auto &worker:workers_) {
+				worker.join();
+			}
+		}
+
+		/* Includes the calling thread */
+		size_t GetNumThreads() const {
+			return workers_.size() + 1;
+		}
+
+		/* Calls fn(i) for each i in [begin, end) and returns once all calls are complete */
+		void ParallelFor(const size_t begin, const size_t end, const std::function <void(size_t)> &fn) {
+			if(end <= begin) {
+				return;
+			}
+			if(workers_.empty() or end - begin == 1) {
+				for(size_t i = begin; i < end; ++i) {
+					fn(i);
+				}
+				return;
+			}
+			{
+				std::lock_guard <std::mutex> lock(mutex_);
+				task_ = &fn;
+				next_index_ = begin;
+				end_index_ = end;
+				num_active_ = workers_.size();
+				++generation_;
+			}
+			start_cv_.notify_all();
+			RunTask();
+			std::unique_lock <std::mutex> lock(mutex_);
+			done_cv_.wait(lock, [&] { return num_active_ == 0; });
+			task_ = nullptr;
+		}
+
+	};
+
+} // namespace lclibrary
+
+#endif /* LCLIBRARY_UTILS_THREAD_POOL_H_ */
@@ -0,0 +1,170 @@
+/**
+ * This file is part of the LineCoverage-library.
+ * The file contains the table of turning costs between arcs that meet at a vertex
+ *
+ * TODO:
+ *
+ * @author Saurav Agarwal
+ * @contact sagarw10@uncc.edu
+ * @contact agr.saurav1@gmail.com
+ * Repository: https://github.com/UNCCharlotte-Robotics/LineCoverage-library
+ *
+ * Copyright (C) 2020--2022 University of North Carolina at Charlotte.
+ * The LineCoverage-library is owned by the University of North Carolina at Charlotte and is protected by United States copyright laws and applicable international treaties and/or conventions.
+ *
+ * The LineCoverage-library is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * DISCLAIMER OF WARRANTIES: THE SOFTWARE IS PROVIDED "AS-IS" WITHOUT WARRANTY OF ANY KIND INCLUDING ANY WARRANTIES OF PERFORMANCE OR MERCHANTABILITY OR FITNESS FOR A PARTICULAR USE OR PURPOSE OR OF NON-INFRINGEMENT. YOU BEAR ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE SOFTWARE OR HARDWARE.
+ *
+ * SUPPORT AND MAINTENANCE: No support, installation, or training is provided.
+ *
+ * You should have received a copy of the GNU General Public License along with LineCoverage-library. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LCLIBRARY_UTILS_TURN_COST_TABLE_H_
+#define LCLIBRARY_UTILS_TURN_COST_TABLE_H_
+
+#include <lclibrary/core/constants.h>
+#include <lclibrary/core/graph.h>
+#include <lclibrary/utils/edge_cost_with_circular_turns.h>
+#include <lclibrary/utils/thread_pool.h>
+#include <memory>
+#include <vector>
+
+namespace lclibrary {
+
+	/* Turning costs of all pairs of arcs that meet at a vertex, computed once per graph.
+	 * Arcs are numbered as in APSP_Turns: required edges, reversed required edges, non-required edges, reversed non-required edges.
+	 * The costs at vertex v form a block of in-degree x out-degree x 4 entries, one for each combination of servicing the incoming and the outgoing arc.
+	 * Turns that the cost function cannot evaluate are NaN. */
+	class TurnCostTable {
+		std::shared_ptr <const Graph> g_;
+		std::shared_ptr <const EdgeCost_CircularTurns> cost_fn_;
+		size_t n_;
+		size_t m_;
+		size_t m_nr_;
+		size_t num_arcs_;
+		std::vector <const Edge *> edge_;
+		std::vector <bool> rev_;
+		std::vector <size_t> tail_, head_;
+		/* Arcs leaving vertex v are out_arcs_[out_offsets_[v]] to out_arcs_[out_offsets_[v + 1] - 1], in increasing order; likewise for the arcs entering v. out_slot_[a] is the position of arc a among the arcs leaving its tail. */
+		std::vector <size_t> out_offsets_, out_arcs_, out_slot_;
+		std::vector <size_t> in_offsets_, in_arcs_, in_slot_;
+		std::vector <size_t> table_offsets_;
+		std::vector <double> table_;
+
+		void BucketArcs(const std::vector <size_t> &vertex, std::vector <size_t> &offsets, std::vector <size_t> &arcs, std::vector <size_t> &slot) const {
+			offsets.assign(n_ + 1, 0);
+			for(size_t a = 0; a < num_arcs_; ++a) {
+				++offsets[vertex[a] + 1];
+			}
+			for(size_t v = 0; v < n_; ++v) {
+				offsets[v + 1] += offsets[v];
+			}
+			arcs.resize(num_arcs_);
+			slot.resize(num_arcs_);
+			std::vector <size_t> position(offsets.begin(), offsets.end() - 1);
+			for(size_t a = 0; a < num_arcs_; ++a) {
+				size_t v = vertex[a];
+				slot[a] = position[v] - offsets[v];
+				arcs[position[v]++] = a;
+			}
+		}
+
+		inline size_t GetOutDegree(const size_t v) const {
+			return out_offsets_[v + 1] - out_offsets_[v];
+		}
+
+		public:
+		TurnCostTable(const std::shared_ptr <const Graph> &g, const std::shared_ptr <const EdgeCost_CircularTurns> &cost_fn) : g_{g}, cost_fn_{cost_fn} {
+			n_ = g_->GetN();
+			m_ = g_->GetM();
+			m_nr_ = g_->GetMnr();
+			num_arcs_ = 2 * m_ + 2 * m_nr_;
+			edge_.reserve(num_arcs_);
+			rev_.reserve(num_arcs_);
+			tail_.reserve(num_arcs_);
+			head_.reserve(num_arcs_);
+			for(bool req:{kIsRequired, kIsNotRequired}) {
+				size_t num_edges = req == kIsRequired ? m_ : m_nr_;
+				for(bool rev:{false, true}) {
+					for(size_t i = 0; i < num_edges; ++i) {
+						size_t t, h;
+						g_->GetVerticesIndexOfEdge(i, t, h, req);
+						edge_.push_back(g_->GetEdge(i, req));
+						rev_.push_back(rev);
+						tail_.push_back(rev ? h : t);
+						head_.push_back(rev ? t : h);
+					}
+				}
+			}
+			BucketArcs(tail_, out_offsets_, out_arcs_, out_slot_);
+			BucketArcs(head_, in_offsets_, in_arcs_, in_slot_);
+			table_offsets_.assign(n_ + 1, 0);
+			for(size_t v = 0; v < n_; ++v) {
+				table_offsets_[v + 1] = table_offsets_[v] + 4 * (in_offsets_[v + 1] - in_offsets_[v]) * GetOutDegree(v);
+			}
+		}
+
+		/* Fills the table; the vertices are distributed over a thread pool */
+		void ComputeTurnCosts(const size_t num_threads = 0) {
+			table_.assign(table_offsets_[n_], kDoubleNaN);
+			ThreadPool pool(num_threads);
+			pool.ParallelFor(0, n_, [&](size_t v) {
+					double *entry = &table_[table_offsets_[v]];
+					for(size_t in_iter = in_offsets_[v]; in_iter < in_offsets_[v + 1]; ++in_iter) {
+						size_t a1 = in_arcs_[in_iter];
+						for(size_t out_iter = out_offsets_[v]; out_iter < out_offsets_[v + 1]; ++out_iter) {
+							size_t a2 = out_arcs_[out_iter];
+							for(bool serv1:{false, true}) {
+								for(bool serv2:{false, true}) {
+									double cost = kDoubleNaN;
+									if(cost_fn_->ComputeTurnCost(edge_[a1], edge_[a2], serv1, serv2, rev_[a1], rev_[a2], cost) == kSuccess) {
+										*entry = cost;
+									}
+									++entry;
+								}
+							}
+						}
+					}
+					});
+		}
+
+		inline size_t GetArcIndex(const size_t edge_index, const bool req, const bool rev) const {
+			return 2 * m_ * size_t(not req) + size_t(rev) * (req ? m_ : m_nr_) + edge_index;
+		}
+
+		/* NaN if arc2 does not leave the head of arc1 or the cost function failed */
+		inline double GetTurnCost(const size_t arc1, const size_t arc2, const bool serv1, const bool serv2) const {
+			const size_t v = head_[arc1];
+			if(tail_[arc2] != v) {
+				return kDoubleNaN;
+			}
+			return table_[table_offsets_[v] + 4 * (in_slot_[arc1] * GetOutDegree(v) + out_slot_[arc2]) + 2 * size_t(serv1) + size_t(serv2)];
+		}
+
+		inline double GetTurnCost(const GraphEdge &e1, const GraphEdge &e2) const {
+			return GetTurnCost(GetArcIndex(e1.edge_index_, e1.req_, e1.rev_), GetArcIndex(e2.edge_index_, e2.req_, e2.rev_), e1.serv_, e2.serv_);
+		}
+
+		size_t GetNumArcs() const { return num_arcs_; }
+		size_t GetTail(const size_t a) const { return tail_[a]; }
+		size_t GetHead(const size_t a) const { return head_[a]; }
+		size_t GetOutBegin(const size_t v) const { return out_offsets_[v]; }
+		size_t GetOutEnd(const size_t v) const { return out_offsets_[v + 1]; }
+		size_t GetOutArc(const size_t k) const { return out_arcs_[k]; }
+		size_t GetInBegin(const size_t v) const { return in_offsets_[v]; }
+		size_t GetInEnd(const size_t v) const { return in_offsets_[v + 1]; }
+		size_t GetInArc(const size_t k) const { return in_arcs_[k]; }
+
+		size_t MemoryFootprint() const {
+			size_t bytes = VectorBytes(edge_) + rev_.capacity() / 8 + VectorBytes(tail_) + VectorBytes(head_);
+			bytes += VectorBytes(out_offsets_) + VectorBytes(out_arcs_) + VectorBytes(out_slot_);
+			bytes += VectorBytes(in_offsets_) + VectorBytes(in_arcs_) + VectorBytes(in_slot_);
+			return bytes + VectorBytes(table_offsets_) + VectorBytes(table_);
+		}
+	};
+
+} // namespace lclibrary
+
+#endif /* LCLIBRARY_UTILS_TURN_COST_TABLE_H_ */
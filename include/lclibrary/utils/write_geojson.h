@@ -33,6 +33,33 @@
 
 namespace lclibrary {
 
+	/*! Writes every segment of the polyline of edge i as a feature */
+	inline void WriteGeoJSON_EdgeFeatures(
+			std::ofstream &out_file,
+			const std::shared_ptr <const Graph> &g,
+			const size_t i,
+			const bool is_req,
+			bool &init){
+		const Edge *e = g->GetEdge(i, is_req);
+		for (size_t k = 1; k < e->GetNumPolylinePoints(); ++k){
+			double tLLA[3], hLLA[3];
+			e->GetPolylinePoint(k - 1).GetLLA(tLLA);
+			e->GetPolylinePoint(k).GetLLA(hLLA);
+			if (init == false) {
+				out_file << "{\n";
+				init = true;
+			}
+			else {
+				out_file << ", {\n";
+			}
+			out_file << "\t\"type\": \"Feature\",\n";
+			out_file << "\t\"req\": \"" << (is_req ? "true" : "false") << "\",\n";
+			out_file << "\t\"geometry\": {\n";
+			out_file << "\t\"type\": \"LineString\",\n";
+			out_file << "\t\"coordinates\": [["<< tLLA[1] <<", "<<tLLA[0]<<"], [" <<hLLA[1]<<", "<<hLLA[0]<<"]]\n}\n}";
+		}
+	}
+
 	inline void WriteGeoJSON_Req(
 			const std::shared_ptr <const Graph> &g,
 			const std::string filename,
@@ -40,19 +67,10 @@ namespace lclibrary {
 		std::ofstream out_file (filename);
 		out_file.precision(16);
 		auto m = g->GetM();
+		bool init = false;
 		out_file << "var "<< varName <<" = [";
 		for (size_t i = 0; i < m; ++i){
-			double tLLA[3], hLLA[3];
-			g->GetVertexLLAofEdge(i, tLLA, hLLA, kIsRequired);
-			if (i == 0)
-				out_file << "{\n";
-			else
-				out_file << ", {\n";
-			out_file << "\t\"type\": \"Feature\",\n";
-			out_file << "\t\"req\": \"true\",\n";
-			out_file << "\t\"geometry\": {\n";
-			out_file << "\t\"type\": \"LineString\",\n";
-			out_file << "\t\"coordinates\": [["<< tLLA[1] <<", "<<tLLA[0]<<"], [" <<hLLA[1]<<", "<<hLLA[0]<<"]]\n}\n}";
+			WriteGeoJSON_EdgeFeatures(out_file, g, i, kIsRequired, init);
 		}
 		out_file << "];";
 		out_file.close();
@@ -68,36 +86,10 @@ namespace lclibrary {
 		bool init = false;
 		out_file << "var "<< varName <<" = [";
 		for (size_t i = 0; i < m; ++i){
-			double tLLA[3], hLLA[3];
-			g->GetVertexLLAofEdge(i, tLLA, hLLA, kIsRequired);
-			if (init == false) {
-				out_file << "{\n";
-				init = true;
-			}
-			else {
-				out_file << ", {\n";
-			}
-			out_file << "\t\"type\": \"Feature\",\n";
-			out_file << "\t\"req\": \"true\",\n";
-			out_file << "\t\"geometry\": {\n";
-			out_file << "\t\"type\": \"LineString\",\n";
-			out_file << "\t\"coordinates\": [["<< tLLA[1] <<", "<<tLLA[0]<<"], [" <<hLLA[1]<<", "<<hLLA[0]<<"]]\n}\n}";
+			WriteGeoJSON_EdgeFeatures(out_file, g, i, kIsRequired, init);
 		}
 		for (size_t i = 0; i < m_nr; ++i){
-			double tLLA[3], hLLA[3];
-			g->GetVertexLLAofEdge(i, tLLA, hLLA, kIsNotRequired);
-			if (init == false) {
-				out_file << "{\n";
-				init = true;
-			}
-			else {
-				out_file << ", {\n";
-			}
-			out_file << "\t\"type\": \"Feature\",\n";
-			out_file << "\t\"req\": \"false\",\n";
-			out_file << "\t\"geometry\": {\n";
-			out_file << "\t\"type\": \"LineString\",\n";
-			out_file << "\t\"coordinates\": [["<< tLLA[1] <<", "<<tLLA[0]<<"], [" <<hLLA[1]<<", "<<hLLA[0]<<"]]\n}\n}";
+			WriteGeoJSON_EdgeFeatures(out_file, g, i, kIsNotRequired, init);
 		}
 		out_file << "];";
 		out_file.close();
@@ -0,0 +1,113 @@
+/**
+ * This file is part of the LineCoverage-library.
+ * Benchmark of the point-to-point queries of APSP_ContractionHierarchy against APSP_FloydWarshall
+ *
+ * TODO:
+ *
+ * @author Saurav Agarwal
+ * @contact sagarw10@uncc.edu
+ * @contact agr.saurav1@gmail.com
+ * Repository: https://github.com/UNCCharlotte-Robotics/LineCoverage-library
+ *
+ * Copyright (C) 2020--2022 University of North Carolina at Charlotte.
+ * The LineCoverage-library is owned by the University of North Carolina at Charlotte and is protected by United States copyright laws and applicable international treaties and/or conventions.
+ *
+ * The LineCoverage-library is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * DISCLAIMER OF WARRANTIES: THE SOFTWARE IS PROVIDED "AS-IS" WITHOUT WARRANTY OF ANY KIND INCLUDING ANY WARRANTIES OF PERFORMANCE OR MERCHANTABILITY OR FITNESS FOR A PARTICULAR USE OR PURPOSE OR OF NON-INFRINGEMENT. YOU BEAR ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE SOFTWARE OR HARDWARE.
+ *
+ * SUPPORT AND MAINTENANCE: No support, installation, or training is provided.
+ *
+ * You should have received a copy of the GNU General Public License along with LineCoverage-library. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lclibrary_config.h>
+#include <lclibrary/core/config.h>
+#include <lclibrary/core/core.h>
+#include <lclibrary/core/graph_wrapper.h>
+#include <lclibrary/algorithms/apsp.h>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <unistd.h>
+
+int main (int argc, char **argv) {
+	if(argc < 2) {
+		std::cerr << "Usage: " << argv[0] << " <config_file.yaml> [num_queries]" << std::endl;
+		return 1;
+	}
+
+	std::string config_file = argv[1];
+	lclibrary::Config config(config_file);
+	size_t num_queries = 1000000;
+	if(argc == 3) {
+		num_queries = std::stoul(argv[2]);
+	}
+
+	if (config.ParseConfig()) {
+		std::cerr << "Config parsing failed with config file: " << config_file << std::endl;
+	}
+
+	std::shared_ptr <lclibrary::Graph> g;
+	if(lclibrary::GraphCreateWithCostFn(config, g)) {
+		std::cerr << "Graph creation failed\n";
+		return 1;
+	}
+	g->PrintNM();
+	const size_t n = g->GetN();
+	if(n == 0) {
+		return 0;
+	}
+
+	std::mt19937_64 generator(0);
+	std::uniform_int_distribution <size_t> vertex(0, n - 1);
+	std::vector <std::pair <size_t, size_t>> queries(num_queries);
+	for(auto &query:queries) {
+		query = {vertex(generator), vertex(generator)};
+	}
+
+	auto t_start = std::chrono::high_resolution_clock::now();
+	lclibrary::APSP_ContractionHierarchy ch(g, false, config.apsp);
+	ch.APSP_Deadheading();
+	auto t_end = std::chrono::high_resolution_clock::now();
+	std::cout << "contraction_hierarchy: preprocessing " << std::chrono::duration<double, std::milli>(t_end - t_start).count() << " ms, " << ch.GetNumShortcuts() << " shortcuts\n";
+
+	std::vector <double> ch_costs(num_queries);
+	t_start = std::chrono::high_resolution_clock::now();
+	for(size_t q = 0; q < num_queries; ++q) {
+		ch_costs[q] = ch.GetCost(queries[q].first, queries[q].second);
+	}
+	t_end = std::chrono::high_resolution_clock::now();
+	std::cout << "contraction_hierarchy: " << std::chrono::duration<double, std::nano>(t_end - t_start).count() / num_queries << " ns per GetCost\n";
+
+	/* Floyd-Warshall keeps n x n distance, successor and edge matrices */
+	double physical_bytes = double(sysconf(_SC_PHYS_PAGES)) * sysconf(_SC_PAGE_SIZE);
+	double matrix_bytes = double(n) * n * (sizeof(double) + 2 * sizeof(uint32_t));
+	if(physical_bytes > 0 and matrix_bytes > physical_bytes / 2) {
+		std::cout << "floyd_warshall: skipped, " << matrix_bytes / (1 << 20) << " MB of matrices do not fit in memory\n";
+		return 0;
+	}
+
+	t_start = std::chrono::high_resolution_clock::now();
+	lclibrary::APSP_FloydWarshall fw(g, false, config.apsp);
+	fw.APSP_Deadheading();
+	t_end = std::chrono::high_resolution_clock::now();
+	std::cout << "floyd_warshall: preprocessing " << std::chrono::duration<double, std::milli>(t_end - t_start).count() << " ms\n";
+
+	std::vector <double> fw_costs(num_queries);
+	t_start = std::chrono::high_resolution_clock::now();
+	for(size_t q = 0; q < num_queries; ++q) {
+		fw_costs[q] = fw.GetCost(queries[q].first, queries[q].second);
+	}
+	t_end = std::chrono::high_resolution_clock::now();
+	std::cout << "floyd_warshall: " << std::chrono::duration<double, std::nano>(t_end - t_start).count() / num_queries << " ns per GetCost\n";
+
+	size_t num_mismatches = 0;
+	for(size_t q = 0; q < num_queries; ++q) {
+		if(std::abs(ch_costs[q] - fw_costs[q]) > 1e-9 * std::max(1., std::abs(fw_costs[q]))) {
+			++num_mismatches;
+		}
+	}
+	std::cout << "mismatched costs: " << num_mismatches << " of " << num_queries << std::endl;
+	return num_mismatches == 0 ? 0 : 1;
+}
@@ -97,10 +97,13 @@ int main (int argc, char **argv) {
 
 	std::shared_ptr <lclibrary::Graph> g;
 
+	lclibrary::StageMemoryTracker memory_tracker;
+	memory_tracker.StartStage("graph");
 	if(lclibrary::GraphCreateWithCostFn(config, g)) {
 		std::cerr << "Graph creation failed\n";
 		return 1;
 	}
+	memory_tracker.EndStage();
 	g->PrintNM();
 
 	if(g->IsDepotSet() == false){
@@ -128,6 +131,8 @@ int main (int argc, char **argv) {
 	}
 
 	mlc_solver->Use2Opt(config.use_2opt);
+	mlc_solver->SetAPSPOptions(config.apsp);
+	memory_tracker.StartStage("solve");
 	solver_status = mlc_solver->Solve();
 
 	if(config.solver_mlc == "ilp_gurobi") {
@@ -150,6 +155,12 @@ int main (int argc, char **argv) {
 	auto t_end_all = std::chrono::high_resolution_clock::now();
 	double elapsed_time_ms = std::chrono::duration<double, std::milli>(t_end_all - t_start_all).count();
 
+	memory_tracker.EndStage();
+	lclibrary::MemoryFootprintList memory_footprint;
+	memory_footprint.emplace_back("graph", g->MemoryFootprint());
+	mlc_solver->GetMemoryFootprint(memory_footprint);
+	lclibrary::PrintMemoryFootprint(config.solver_mlc, memory_footprint);
+
 	std::cout << std::boolalpha;
 	std::cout << config.problem << ": " << config.solver_mlc << ": solution connectivity check " << mlc_solver->CheckSolution() << std::endl;
 
@@ -168,12 +179,19 @@ int main (int argc, char **argv) {
 		result_file << g->GetN() << " " << g->GetM() << " " << g->GetMnr() << " " << g->GetLength() << " " << lclibrary::GetNumCCRequiredGraph(g);
 
 		if(config.solver_mlc == "mem") {
-			result_file << " " << mlc_solver->GetRouteCost() << " " << mlc_solver->GetNumOfRoutes() << " " << elapsed_time_ms  << " " << solver_status << " " << mlc_solver->CheckSolution() << std::endl;
+			result_file << " " << mlc_solver->GetRouteCost() << " " << mlc_solver->GetNumOfRoutes() << " " << elapsed_time_ms  << " " << solver_status << " " << mlc_solver->CheckSolution();
 		}
 
 		if(config.solver_mlc == "ilp_gurobi") {
-			result_file << " " << mlc_solver->GetRouteCost() << " " << mlc_solver->GetNumOfRoutes() << " " << mlc_solver->GetObjBound() << " " << elapsed_time_ms  << " " << solver_status << " " << mlc_solver->CheckSolution()<< std::endl;
+			result_file << " " << mlc_solver->GetRouteCost() << " " << mlc_solver->GetNumOfRoutes() << " " << mlc_solver->GetObjBound() << " " << elapsed_time_ms  << " " << solver_status << " " << mlc_solver->CheckSolution();
+		}
+
+		/* Bytes of the graph and of the solver, then the peak resident set size of each stage */
+		result_file << " " << memory_footprint.front().second << " " << lclibrary::SumMemoryFootprint(memory_footprint) - memory_footprint.front().second;
+		for(const auto &stage:memory_tracker.GetStages()) {
+			result_file << " " << stage.second;
 		}
+		result_file << std::endl;
 
 		result_file.close();
 	}
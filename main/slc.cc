@@ -79,10 +79,13 @@ int main (int argc, char **argv) {
 
 	std::shared_ptr <lclibrary::Graph> g;
 
+	lclibrary::StageMemoryTracker memory_tracker;
+	memory_tracker.StartStage("graph");
 	if(lclibrary::GraphCreateWithCostFn(config, g)) {
 		std::cerr << "Graph creation failed\n";
 		return 1;
 	}
+	memory_tracker.EndStage();
 
 	if(g->IsDepotSet()){
 		if(g->CheckDepotRequiredVertex() == lclibrary::kFail) {
@@ -117,6 +120,8 @@ int main (int argc, char **argv) {
 	}
 
 	slc_solver->Use2Opt(config.use_2opt);
+	slc_solver->SetAPSPOptions(config.apsp);
+	memory_tracker.StartStage("solve");
 	solver_status = slc_solver->Solve();
 
 	if(config.solver_slc == "ilp_gurobi") {
@@ -138,6 +143,12 @@ int main (int argc, char **argv) {
 	double elapsed_time_ms = std::chrono::duration<double, std::milli>(t_end_all - t_start_all).count();
 
 
+	memory_tracker.EndStage();
+	lclibrary::MemoryFootprintList memory_footprint;
+	memory_footprint.emplace_back("graph", g->MemoryFootprint());
+	slc_solver->GetMemoryFootprint(memory_footprint);
+	lclibrary::PrintMemoryFootprint(config.solver_slc, memory_footprint);
+
 	std::cout << std::boolalpha;
 	std::cout << config.problem << ": " << config.solver_slc << ": solution connectivity check " << slc_solver->CheckSolution() << std::endl;
 
@@ -161,12 +172,19 @@ int main (int argc, char **argv) {
 			slc_solver->GetComputationTimes(comp_t);
 			slc_solver->GetCosts(costs);
 			result_file << " " << config.use_2opt << " " << slc_solver->GetNumLocalMoves() << " " << comp_t[0] << " " << comp_t[1] << " " << comp_t[2] << " " << comp_t[3] << " " << time_all;
-			result_file << " " << costs[0] << " " << costs[1] << std::endl;
+			result_file << " " << costs[0] << " " << costs[1];
 		}
 
 		if(config.solver_slc == "ilp_gurobi" or config.solver_slc == "ilp_glpk") {
-			result_file << " " << slc_solver->GetRouteCost() << " " << elapsed_time_ms  << " " << solver_status << " " << slc_solver->CheckSolution() << std::endl;
+			result_file << " " << slc_solver->GetRouteCost() << " " << elapsed_time_ms  << " " << solver_status << " " << slc_solver->CheckSolution();
+		}
+
+		/* Bytes of the graph and of the solver, then the peak resident set size of each stage */
+		result_file << " " << memory_footprint.front().second << " " << lclibrary::SumMemoryFootprint(memory_footprint) - memory_footprint.front().second;
+		for(const auto &stage:memory_tracker.GetStages()) {
+			result_file << " " << stage.second;
 		}
+		result_file << std::endl;
 
 		result_file.close();
 	}
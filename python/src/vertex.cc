@@ -26,6 +26,7 @@
 #include <lclibrary/core/vertex.h>
 #include <lclibrary/core/edge.h>
 #include <lclibrary/core/graph.h>
+#include <lclibrary/core/graph_builder.h>
 #include <lclibrary/core/route.h>
 #include <lclibrary/slc/rpp_3by2.h>
 
@@ -59,7 +60,11 @@ b_np::ndarray SolveRPP(b_np::ndarray const &vertex_ids, b_np::ndarray const &edg
 	std::vector <lclibrary::Edge> edge_list;
 	VertexVecFromBnpArray(vertex_ids, vertices);
 	EdgeVecFromBnpArray(edges_tail, edges_head, edges_req, edges_cost, edge_list);
-	auto graph = std::make_shared <lclibrary::Graph>(vertices, edge_list);
+	std::shared_ptr <lclibrary::Graph> graph;
+	lclibrary::GraphBuilder graph_builder(std::move(vertices), std::move(edge_list));
+	if(graph_builder.Build(graph)) {
+		return b_np::zeros(boost::python::make_tuple(0, 3), b_np::dtype::get_builtin<int>());
+	}
 	lclibrary::SLC_RPP slc_rpp(graph);
 	slc_rpp.Solve();
 	lclibrary::Route route;
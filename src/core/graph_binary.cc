@@ -0,0 +1,267 @@
+/**
+ * This file is part of the LineCoverage-library.
+ * The file contains the reader and writer of the binary graph format
+ *
+ * TODO:
+ *
+ * @author Saurav Agarwal
+ * @contact sagarw10@uncc.edu
+ * @contact agr.saurav1@gmail.com
+ * Repository: https://github.com/UNCCharlotte-Robotics/LineCoverage-library
+ *
+ * Copyright (C) 2020--2022 University of North Carolina at Charlotte.
+ * The LineCoverage-library is owned by the University of North Carolina at Charlotte and is protected by United States copyright laws and applicable international treaties and/or conventions.
+ *
+ * The LineCoverage-library is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * DISCLAIMER OF WARRANTIES: THE SOFTWARE IS PROVIDED "AS-IS" WITHOUT WARRANTY OF ANY KIND INCLUDING ANY WARRANTIES OF PERFORMANCE OR MERCHANTABILITY OR FITNESS FOR A PARTICULAR USE OR PURPOSE OR OF NON-INFRINGEMENT. YOU BEAR ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE SOFTWARE OR HARDWARE.
+ *
+ * SUPPORT AND MAINTENANCE: No support, installation, or training is provided.
+ *
+ * You should have received a copy of the GNU General Public License along with LineCoverage-library. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lclibrary/core/graph_io.h>
+#include <lclibrary/utils/fingerprint.h>
+#include <lclibrary/utils/mapped_file.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <unistd.h>
+
+namespace lclibrary {
+
+	/* File layout: GraphBinaryHeader, the size in bytes of each section (uint64), then the sections, each starting at a multiple of kAlignment. Sections: vertex IDs (uint64), vertex XY (2 doubles per vertex), vertex LLA (3 doubles per vertex), tail and head IDs of the edges (uint64, required edges first), the costs and demands of the edges (kNumEdgeColumns doubles per edge, see EdgeColumns()), and the depot IDs (uint64). Values are stored in the byte order of the machine that wrote the file; a machine with the other order rejects it by its version field. */
+	static constexpr size_t kAlignment = 64;
+	static constexpr uint32_t kVersion = 1;
+	static constexpr size_t kNumSections = 7;
+	static constexpr size_t kNumEdgeColumns = 10;
+	static constexpr uint32_t kDepotSet = 1;
+	static constexpr uint32_t kMultipleDepotsSet = 2;
+
+	struct GraphBinaryHeader {
+		char magic[8];
+		uint32_t version;
+		uint32_t flags;
+		uint64_t n;
+		uint64_t m;
+		uint64_t m_nr;
+		uint64_t num_depots;
+		uint64_t depot_id;
+		uint64_t checksum; /* Of the sections, in order */
+	};
+
+	static void SetMagic(GraphBinaryHeader &header) {
+		std::memcpy(header.magic, "LCGRAPH\0", 8);
+	}
+
+	static size_t AlignUp(const size_t offset) {
+		return (offset + kAlignment - 1) / kAlignment * kAlignment;
+	}
+
+	static void EdgeColumns(const Edge &e, double *columns) {
+		columns[0] = e.GetCost();
+		columns[1] = e.GetServiceCost();
+		columns[2] = e.GetReverseServiceCost();
+		columns[3] = e.GetDeadheadCost();
+		columns[4] = e.GetReverseDeadheadCost();
+		columns[5] = e.GetDemand();
+		columns[6] = e.GetServiceDemand();
+		columns[7] = e.GetReverseServiceDemand();
+		columns[8] = e.GetDeadheadDemand();
+		columns[9] = e.GetReverseDeadheadDemand();
+	}
+
+	static std::vector <size_t> SectionBytes(const GraphBinaryHeader &header) {
+		const size_t num_edges = header.m + header.m_nr;
+		return {header.n * sizeof(uint64_t), 2 * header.n * sizeof(double), 3 * header.n * sizeof(double), num_edges * sizeof(uint64_t), num_edges * sizeof(uint64_t), kNumEdgeColumns * num_edges * sizeof(double), header.num_depots * sizeof(uint64_t)};
+	}
+
+	int WriteGraphBinary(std::shared_ptr <const Graph> g, const std::string &file_name) {
+		const size_t n = g->GetN(), m = g->GetM(), m_nr = g->GetMnr();
+		std::vector <uint64_t> vertex_IDs(n);
+		std::vector <double> vertex_xy(2 * n), vertex_lla(3 * n);
+		for(size_t i = 0; i < n; ++i) {
+			vertex_IDs[i] = g->GetVertexID(i);
+			Vec2d xy;
+			g->GetVertexXY(i, xy);
+			vertex_xy[2 * i] = xy.x;
+			vertex_xy[2 * i + 1] = xy.y;
+			g->GetVertexLLA(i, &vertex_lla[3 * i]);
+		}
+		std::vector <uint64_t> tail_IDs, head_IDs;
+		std::vector <double> edge_columns(kNumEdgeColumns * (m + m_nr));
+		tail_IDs.reserve(m + m_nr);
+		head_IDs.reserve(m + m_nr);
+		for(bool req:{kIsRequired, kIsNotRequired}) {
+			const size_t num_edges = req == kIsRequired ? m : m_nr;
+			for(size_t i = 0; i < num_edges; ++i) {
+				const Edge *e = g->GetEdge(i, req);
+				EdgeColumns(*e, &edge_columns[kNumEdgeColumns * tail_IDs.size()]);
+				tail_IDs.push_back(e->GetTailVertexID());
+				head_IDs.push_back(e->GetHeadVertexID());
+			}
+		}
+		std::vector <size_t> depot_IDs;
+		g->GetDepotIDs(depot_IDs);
+		std::vector <uint64_t> depots(depot_IDs.begin(), depot_IDs.end());
+
+		GraphBinaryHeader header;
+		std::memset(&header, 0, sizeof(GraphBinaryHeader));
+		SetMagic(header);
+		header.version = kVersion;
+		header.flags = (g->IsDepotSet() ? kDepotSet : 0) | (g->IsMultipleDepotSet() ? kMultipleDepotsSet : 0);
+		header.n = n;
+		header.m = m;
+		header.m_nr = m_nr;
+		header.num_depots = depots.size();
+		header.depot_id = g->IsDepotSet() ? g->GetDepotID() : 0;
+		const std::vector <const void *> sections{vertex_IDs.data(), vertex_xy.data(), vertex_lla.data(), tail_IDs.data(), head_IDs.data(), edge_columns.data(), depots.data()};
+		const std::vector <size_t> section_bytes = SectionBytes(header);
+		for(size_t k = 0; k < kNumSections; ++k) {
+			header.checksum = Checksum(sections[k], section_bytes[k], header.checksum);
+		}
+
+		/* Written to a temporary file that is then renamed, so concurrent runs never see a partial file */
+		std::string tmp_file_name = file_name + ".tmp" + std::to_string(getpid());
+		std::ofstream out(tmp_file_name, std::ios::binary);
+		if(not out) {
+			std::cerr << "Cannot open " << tmp_file_name << std::endl;
+			return kFail;
+		}
+		out.write(reinterpret_cast <const char *> (&header), sizeof(GraphBinaryHeader));
+		for(const auto &num_bytes:section_bytes) {
+			uint64_t num_bytes_64 = num_bytes;
+			out.write(reinterpret_cast <const char *> (&num_bytes_64), sizeof(uint64_t));
+		}
+		size_t offset = sizeof(GraphBinaryHeader) + kNumSections * sizeof(uint64_t);
+		const char padding[kAlignment] = {};
+		for(size_t k = 0; k < kNumSections; ++k) {
+			out.write(padding, AlignUp(offset) - offset);
+			offset = AlignUp(offset);
+			out.write(static_cast <const char *> (sections[k]), section_bytes[k]);
+			offset += section_bytes[k];
+		}
+		out.close();
+		std::error_code ec;
+		if(not out) {
+			std::filesystem::remove(tmp_file_name, ec);
+			std::cerr << "Could not write " << file_name << std::endl;
+			return kFail;
+		}
+		std::filesystem::rename(tmp_file_name, file_name, ec);
+		if(ec) {
+			std::filesystem::remove(tmp_file_name, ec);
+			std::cerr << "Could not write " << file_name << std::endl;
+			return kFail;
+		}
+		return kSuccess;
+	}
+
+	int ReadGraphBinary(std::shared_ptr <Graph> &g, const std::string &file_name) {
+		MappedFile file;
+		if(file.Open(file_name) == kFail) {
+			std::cerr << "Cannot open " << file_name << std::endl;
+			return kFail;
+		}
+		const char *data = file.GetData();
+		size_t offset = sizeof(GraphBinaryHeader) + kNumSections * sizeof(uint64_t);
+		GraphBinaryHeader header, expected;
+		SetMagic(expected);
+		if(file.GetSize() < offset) {
+			std::cerr << file_name << " is not a graph file\n";
+			return kFail;
+		}
+		std::memcpy(&header, data, sizeof(GraphBinaryHeader));
+		if(std::memcmp(header.magic, expected.magic, 8) != 0 or std::max({header.n, header.m + header.m_nr, header.num_depots}) > file.GetSize()) {
+			std::cerr << file_name << " is not a graph file\n";
+			return kFail;
+		}
+		if(header.version != kVersion) {
+			std::cerr << file_name << " has graph format version " << header.version << ", expected " << kVersion << std::endl;
+			return kFail;
+		}
+		const std::vector <size_t> section_bytes = SectionBytes(header);
+		std::vector <const char *> sections(kNumSections);
+		uint64_t checksum = 0;
+		for(size_t k = 0; k < kNumSections; ++k) {
+			uint64_t num_bytes;
+			std::memcpy(&num_bytes, data + sizeof(GraphBinaryHeader) + k * sizeof(uint64_t), sizeof(uint64_t));
+			offset = AlignUp(offset);
+			if(num_bytes != section_bytes[k] or offset + num_bytes > file.GetSize()) {
+				std::cerr << file_name << " is truncated or corrupt\n";
+				return kFail;
+			}
+			sections[k] = data + offset;
+			checksum = Checksum(sections[k], num_bytes, checksum);
+			offset += num_bytes;
+		}
+		if(checksum != header.checksum) {
+			std::cerr << "Checksum mismatch in " << file_name << std::endl;
+			return kFail;
+		}
+
+		/* The sections are aligned, so they can be read in place */
+		const uint64_t *vertex_IDs = reinterpret_cast <const uint64_t *> (sections[0]);
+		const double *vertex_xy = reinterpret_cast <const double *> (sections[1]);
+		const double *vertex_lla = reinterpret_cast <const double *> (sections[2]);
+		const uint64_t *tail_IDs = reinterpret_cast <const uint64_t *> (sections[3]);
+		const uint64_t *head_IDs = reinterpret_cast <const uint64_t *> (sections[4]);
+		const double *edge_columns = reinterpret_cast <const double *> (sections[5]);
+		const uint64_t *depots = reinterpret_cast <const uint64_t *> (sections[6]);
+
+		GraphBuilder graph_builder;
+		graph_builder.Reserve(header.n, header.m + header.m_nr);
+		for(size_t i = 0; i < header.n; ++i) {
+			Vertex new_vertex(vertex_IDs[i]);
+			new_vertex.SetXY(vertex_xy[2 * i], vertex_xy[2 * i + 1]);
+			new_vertex.SetLLA(vertex_lla[3 * i], vertex_lla[3 * i + 1], vertex_lla[3 * i + 2]);
+			graph_builder.AddVertex(new_vertex);
+		}
+		for(size_t i = 0; i < header.m + header.m_nr; ++i) {
+			const double *columns = edge_columns + kNumEdgeColumns * i;
+			Edge new_edge(tail_IDs[i], head_IDs[i], i < header.m ? kIsRequired : kIsNotRequired, columns[1], columns[2], columns[3], columns[4]);
+			new_edge.SetCost(columns[0]);
+			new_edge.SetDemand(columns[5]);
+			new_edge.SetServiceDemands(columns[6], columns[7]);
+			new_edge.SetDeadheadDemands(columns[8], columns[9]);
+			graph_builder.AddEdge(new_edge);
+		}
+		if(graph_builder.Build(g) == kFail) {
+			return kFail;
+		}
+		if(header.flags & kDepotSet) {
+			if(g->SetDepot(header.depot_id) == kFail) {
+				return kFail;
+			}
+		}
+		if(header.flags & kMultipleDepotsSet) {
+			if(g->AddDepots(std::vector <size_t> (depots, depots + header.num_depots)) == kFail) {
+				return kFail;
+			}
+		}
+		return kSuccess;
+	}
+
+	int ConvertGraphToBinary(
+			const std::string &vertex_list_file_name,
+			const std::string &req_edge_list_file_name,
+			const std::string &non_req_edge_list_file_name,
+			const std::string &binary_file_name,
+			const bool is_with_lla,
+			const bool is_with_cost) {
+		std::shared_ptr <Graph> g;
+		int status;
+		if(non_req_edge_list_file_name.empty()) {
+			status = FileParser(g, vertex_list_file_name, req_edge_list_file_name, is_with_lla, is_with_cost);
+		} else {
+			status = FileParser(g, vertex_list_file_name, req_edge_list_file_name, non_req_edge_list_file_name, is_with_lla, is_with_cost);
+		}
+		if(status == kFail) {
+			std::cerr << "Graph generation failed" << std::endl;
+			return kFail;
+		}
+		return WriteGraphBinary(g, binary_file_name);
+	}
+
+} // namespace lclibrary
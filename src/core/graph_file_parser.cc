@@ -22,9 +22,95 @@
  */
 
 #include <lclibrary/core/graph_io.h>
+#include <lclibrary/utils/text_record_parser.h>
+#include <unordered_set>
 
 namespace lclibrary {
 
+	/* Keeps the vertices that are incident to an edge, in their order */
+	void FilterVertices (std::vector <Vertex> &vertex_list, const std::vector <Edge> &edge_list) {
+		std::unordered_set <size_t> incident_IDs;
+		incident_IDs.reserve(2 * edge_list.size());
+		for(const auto &e:edge_list) {
+			incident_IDs.insert(e.GetTailVertexID());
+			incident_IDs.insert(e.GetHeadVertexID());
+		}
+		auto is_isolated = [&incident_IDs](const Vertex &v) { return incident_IDs.count(v.GetID()) == 0; };
+		vertex_list.erase(std::remove_if(vertex_list.begin(), vertex_list.end(), is_isolated), vertex_list.end());
+	}
+
+	int VertexParser (std::vector <Vertex> &vertex_list, const std::string &file_name, const bool is_with_lla) {
+		TextRecordParser parser(is_with_lla ? 6 : 3, {0});
+		if(parser.Parse(file_name) == kFail) {
+			return kFail;
+		}
+		const size_t n = parser.GetNumRecords();
+		vertex_list.reserve(vertex_list.size() + n);
+		for(size_t i = 0; i < n; ++i) {
+			Vertex new_vertex(parser.GetID(i, 0));
+			if(is_with_lla) {
+				new_vertex.SetLLA(parser.GetReal(i, 3), parser.GetReal(i, 4), parser.GetReal(i, 5));
+			}
+			new_vertex.SetXY(parser.GetReal(i, 1), parser.GetReal(i, 2));
+			vertex_list.push_back(new_vertex);
+		}
+		return kSuccess;
+	}
+
+	int EdgeParser (std::vector <Edge> &edge_list, const std::string &file_name, const bool req, const bool is_with_cost, size_t &num_edges) {
+		size_t num_columns = 2;
+		if(is_with_cost) {
+			num_columns = req == kIsRequired ? 6 : 4;
+		}
+		TextRecordParser parser(num_columns, {0, 1});
+		if(parser.Parse(file_name) == kFail) {
+			return kFail;
+		}
+		num_edges = parser.GetNumRecords();
+		edge_list.reserve(edge_list.size() + num_edges);
+		for(size_t i = 0; i < num_edges; ++i) {
+			const size_t tail_v_ID = parser.GetID(i, 0), head_v_ID = parser.GetID(i, 1);
+			if(not is_with_cost) {
+				edge_list.push_back(Edge(tail_v_ID, head_v_ID, req));
+			}
+			else if(req == kIsRequired) {
+				edge_list.push_back(Edge(tail_v_ID, head_v_ID, req, parser.GetReal(i, 2), parser.GetReal(i, 3), parser.GetReal(i, 4), parser.GetReal(i, 5)));
+			}
+			else {
+				edge_list.push_back(Edge(tail_v_ID, head_v_ID, req, parser.GetReal(i, 2), parser.GetReal(i, 3)));
+			}
+		}
+		return kSuccess;
+	}
+
+	int FileParser (std::shared_ptr <Graph> &g, const std::string &vertex_list_file_name, const std::string &edge_list_file_name, const bool is_with_lla, const bool is_with_cost, const bool filter_vertices) {
+		std::vector <Vertex> vertex_list;
+		std::vector <Edge> edge_list;
+		size_t m = 0;
+		if(VertexParser(vertex_list, vertex_list_file_name, is_with_lla) == kFail or EdgeParser(edge_list, edge_list_file_name, kIsRequired, is_with_cost, m) == kFail) {
+			return kFail;
+		}
+		if(filter_vertices == true) {
+			FilterVertices(vertex_list, edge_list);
+		}
+		GraphBuilder graph_builder(std::move(vertex_list), std::move(edge_list));
+		return graph_builder.Build(g);
+	}
+
+	int FileParser (std::shared_ptr <Graph> &g, const std::string &vertex_list_file_name, const std::string &req_edge_list_file_name, const std::string &non_req_edge_list_file_name, const bool is_with_lla, const bool is_with_cost, const bool filter_vertices) {
+		std::vector <Vertex> vertex_list;
+		std::vector <Edge> edge_list;
+		size_t m = 0, m_nr = 0;
+		if(VertexParser(vertex_list, vertex_list_file_name, is_with_lla) == kFail or EdgeParser(edge_list, req_edge_list_file_name, kIsRequired, is_with_cost, m) == kFail or EdgeParser(edge_list, non_req_edge_list_file_name, kIsNotRequired, is_with_cost, m_nr) == kFail) {
+			return kFail;
+		}
+		if(filter_vertices == true) {
+			FilterVertices(vertex_list, edge_list);
+		}
+		GraphBuilder graph_builder(std::move(vertex_list), std::move(edge_list));
+		return graph_builder.Build(g);
+	}
+
 	void VertexParser (std::vector <Vertex> &vertex_list, std::ifstream &vertex_list_infile, const bool is_with_lla) {
 		size_t vertex_ID;
 		double lat, lng, alt, x, y;
@@ -45,38 +131,27 @@ namespace lclibrary {
 		}
 	}
 
-	void FileParser (std::shared_ptr <Graph> &g, std::ifstream &vertex_list_infile, std::ifstream &edge_list_infile, const bool is_with_lla, const bool is_with_cost, bool filter_vertices) {
+	int FileParser (std::shared_ptr <Graph> &g, std::ifstream &vertex_list_infile, std::ifstream &edge_list_infile, const bool is_with_lla, const bool is_with_cost, bool filter_vertices) {
 		std::vector <Vertex> vertex_list;
 		VertexParser (vertex_list, vertex_list_infile, is_with_lla);
 		std::vector <Edge> edge_list;
-		size_t m = 0, m_nr = 0;
+		size_t m = 0;
 		EdgeParser (edge_list, edge_list_infile, is_with_cost, m);
 		if(filter_vertices == true) {
-			std::vector <Vertex> filtered_vertex_list;
-			for(const auto &v:vertex_list) {
-				bool found = false;
-				for(const auto &e:edge_list) {
-					if(v.GetID() == e.GetTailVertexID() or v.GetID() == e.GetHeadVertexID()) {
-						found = true;
-						break;
-					}
-				}
-				if(found == true) {
-					filtered_vertex_list.push_back(v);
-				}
-			}
-			vertex_list = filtered_vertex_list;
+			FilterVertices(vertex_list, edge_list);
 		}
-		g = std::make_shared <Graph>(vertex_list, edge_list, m, m_nr);
+		GraphBuilder graph_builder(std::move(vertex_list), std::move(edge_list));
+		return graph_builder.Build(g);
 	}
 
-	void FileParser (std::shared_ptr <Graph> &g, std::ifstream &vertex_list_infile, std::ifstream &req_edge_list_infile, std::ifstream &non_req_edge_list_infile, const bool is_with_lla, const bool is_with_cost, const bool filter_vertices) {
+	int FileParser (std::shared_ptr <Graph> &g, std::ifstream &vertex_list_infile, std::ifstream &req_edge_list_infile, std::ifstream &non_req_edge_list_infile, const bool is_with_lla, const bool is_with_cost, const bool filter_vertices) {
 		std::vector <Vertex> vertex_list;
 		VertexParser (vertex_list, vertex_list_infile, is_with_lla);
 		std::vector <Edge> edge_list;
 		size_t m = 0, m_nr = 0;
 		EdgeParser (edge_list, req_edge_list_infile, non_req_edge_list_infile, is_with_cost, m, m_nr);
-		g = std::make_shared <Graph>(vertex_list, edge_list, m, m_nr);
+		GraphBuilder graph_builder(std::move(vertex_list), std::move(edge_list));
+		return graph_builder.Build(g);
 	}
 
 	void EdgeParser (std::vector <Edge> &edge_list, std::ifstream &edge_list_infile, const bool is_with_cost, size_t &m) {
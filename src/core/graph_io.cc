@@ -34,22 +34,10 @@ namespace lclibrary {
 			const bool is_with_cost,
 			const bool filter_vertices){
 
-		std::ifstream vertex_list_infile (vertex_list_file_name);
-		std::ifstream edge_list_infile (edge_list_file_name);
-
-		if( !vertex_list_infile ) {
-			std::cerr << "Cannot open " << vertex_list_file_name << std::endl;
-			return kFail;
-		}
-		if( !edge_list_infile ) {
-			std::cerr << "Cannot open " << edge_list_file_name << std::endl;
+		if(FileParser(g, vertex_list_file_name, edge_list_file_name, is_with_lla, is_with_cost, filter_vertices)) {
+			std::cerr << "Graph generation failed" << std::endl;
 			return kFail;
 		}
-
-		FileParser(g, vertex_list_infile, edge_list_infile, is_with_lla, is_with_cost, filter_vertices);
-
-		vertex_list_infile.close();
-		edge_list_infile.close();
 		return kSuccess;
 	}
 
@@ -62,28 +50,22 @@ namespace lclibrary {
 			const bool is_with_lla,
 			const bool is_with_cost){
 
-		std::ifstream vertex_list_infile (vertex_list_file_name);
-		std::ifstream req_edge_list_infile (req_edge_list_file_name);
-		std::ifstream non_req_edge_list_infile (non_req_edge_list_file_name);
-
-		if( !vertex_list_infile ) {
-			std::cerr << "Cannot open " << vertex_list_file_name << std::endl;
-			return kFail;
-		}
-		if( !req_edge_list_infile ) {
-			std::cerr << "Cannot open " << req_edge_list_file_name << std::endl;
+		if(FileParser(g, vertex_list_file_name, req_edge_list_file_name, non_req_edge_list_file_name, is_with_lla, is_with_cost)) {
+			std::cerr << "Graph generation failed" << std::endl;
 			return kFail;
 		}
+		return kSuccess;
+	}
 
-		if( !non_req_edge_list_infile ) {
-			std::cerr << "Cannot open " << non_req_edge_list_file_name << std::endl;
+	/*! Create graph from a file in the binary format */
+	int CreateGraph(
+			std::shared_ptr <Graph> &g,
+			const std::string &graph_binary_file_name) {
+
+		if(ReadGraphBinary(g, graph_binary_file_name)) {
+			std::cerr << "Graph generation failed" << std::endl;
 			return kFail;
 		}
-		FileParser(g, vertex_list_infile, req_edge_list_infile, non_req_edge_list_infile, is_with_lla, is_with_cost);
-
-		vertex_list_infile.close();
-		req_edge_list_infile.close();
-		non_req_edge_list_infile.close();
 		return kSuccess;
 	}
 
@@ -124,7 +106,7 @@ namespace lclibrary {
 	}
 
 	/*! Write edge data to file */
-	void WriteRequiredEdges(std::shared_ptr <const Graph> g, const std::string filename) {
+	void WriteRequiredEdges(std::shared_ptr <const Graph> g, const std::string filename, const bool is_with_cost) {
 
 		std::ofstream out_file (filename);
 		out_file.precision(16);
@@ -132,7 +114,10 @@ namespace lclibrary {
 		size_t t_ID, h_ID;
 		for (size_t i = 0; i < m; ++i) {
 			g->GetVerticesIDOfEdge(i, t_ID, h_ID);
-			out_file << t_ID << " " << h_ID << " " << g->GetServiceCost(i)<< " " << g->GetReverseServiceCost(i) << " " << g->GetDeadheadCost(i) << " " << g->GetReverseDeadheadCost(i);
+			out_file << t_ID << " " << h_ID;
+			if(is_with_cost) {
+				out_file << " " << g->GetServiceCost(i)<< " " << g->GetReverseServiceCost(i) << " " << g->GetDeadheadCost(i) << " " << g->GetReverseDeadheadCost(i);
+			}
 			out_file<<"\n";
 		}
 		out_file.close();
@@ -151,6 +136,64 @@ namespace lclibrary {
 		out_file.close();
 	}
 
+	void WriteEdgeShapes(std::shared_ptr <const Graph> g, const std::string &filename) {
+		std::ofstream out_file (filename);
+		out_file.precision(16);
+		size_t m = g->GetM();
+		double lla[3];
+		for (size_t i = 0; i < m; ++i) {
+			const Edge *e = g->GetEdge(i, kIsRequired);
+			if(not e->HasShape()) {
+				continue;
+			}
+			out_file << i << " " << e->GetTailVertexID() << " " << e->GetHeadVertexID() << " " << e->GetNumShapePoints();
+			for(size_t k = 1; k <= e->GetNumShapePoints(); ++k) {
+				const Vertex &v = e->GetPolylinePoint(k);
+				auto xy = v.GetXY();
+				v.GetLLA(lla);
+				out_file << " " << v.GetID() << " " << xy.x << " " << xy.y << " " << lla[0] << " " << lla[1] << " " << lla[2];
+			}
+			out_file << "\n";
+		}
+		out_file.close();
+	}
+
+	int ReadEdgeShapes(std::shared_ptr <Graph> &g, const std::string &filename) {
+		std::ifstream in_file (filename);
+		if(not in_file.is_open()) {
+			std::cerr << "Could not open the edge shapes file " << filename << std::endl;
+			return kFail;
+		}
+		size_t i, t_ID, h_ID, num_points;
+		while(in_file >> i >> t_ID >> h_ID >> num_points) {
+			size_t edge_t_ID, edge_h_ID;
+			if(i < g->GetM()) {
+				g->GetVerticesIDOfEdge(i, edge_t_ID, edge_h_ID, kIsRequired);
+			}
+			if(i >= g->GetM() or edge_t_ID != t_ID or edge_h_ID != h_ID) {
+				std::cerr << "Edge shape " << i << " (" << t_ID << ", " << h_ID << ") does not match the edge list\n";
+				return kFail;
+			}
+			auto shape = std::make_shared <EdgeShape>();
+			shape->reserve(num_points);
+			for(size_t k = 0; k < num_points; ++k) {
+				size_t ID;
+				double x, y, lat, lon, alt;
+				if(not (in_file >> ID >> x >> y >> lat >> lon >> alt)) {
+					std::cerr << "Edge shape " << i << " is incomplete\n";
+					return kFail;
+				}
+				Vertex v(ID);
+				v.SetXY(x, y);
+				v.SetLLA(lat, lon, alt);
+				shape->push_back(v);
+			}
+			g->SetEdgeShape(i, shape, kIsRequired);
+		}
+		in_file.close();
+		return kSuccess;
+	}
+
 	void DepotListParser(const std::string &depot_filename, std::vector <size_t> &depot_ids) {
 		std::ifstream in_file (depot_filename);
 		size_t depot;
@@ -66,6 +66,171 @@ namespace lclibrary {
 		G->AddEdge(edge_list, size_t(0), m_nr);
 	}
 
+	typedef std::vector <std::pair <size_t, bool>> ShapeChain; /* Required edges in the order of travel, and whether each is travelled from head to tail */
+
+	/* Follows the required edges from the vertex start through shape vertices and returns the vertex at which the chain ends */
+	static size_t WalkShapeChain(const Graph &G, const size_t start, const size_t first_edge, const std::vector <bool> &is_shape, const std::vector <std::array <size_t, 2>> &shape_edges, std::vector <bool> &is_visited, ShapeChain &chain) {
+		chain.clear();
+		size_t v = start, edge = first_edge;
+		while(true) {
+			size_t t, h;
+			G.GetVerticesIndexOfEdge(edge, t, h, kIsRequired);
+			const bool is_rev = (t != v);
+			is_visited[edge] = true;
+			chain.push_back(std::make_pair(edge, is_rev));
+			v = is_rev ? t : h;
+			if(not is_shape[v]) {
+				return v;
+			}
+			edge = shape_edges[v][0] == edge ? shape_edges[v][1] : shape_edges[v][0];
+		}
+	}
+
+	/* A chain of one edge is kept as it is */
+	static Edge MergeShapeChain(const Graph &G, const ShapeChain &chain) {
+		if(chain.size() == 1) {
+			return *G.GetEdge(chain[0].first, kIsRequired);
+		}
+		auto shape = std::make_shared <EdgeShape>();
+		double cost = 0, demand = 0;
+		double service_cost = 0, service_cost_rev = 0, deadhead_cost = 0, deadhead_cost_rev = 0;
+		double service_demand = 0, service_demand_rev = 0, deadhead_demand = 0, deadhead_demand_rev = 0;
+		size_t tail_ID = kNIL, head_ID = kNIL;
+		for(const auto &link:chain) {
+			Edge e = *G.GetEdge(link.first, kIsRequired);
+			if(link.second) {
+				e.Reverse();
+			}
+			if(tail_ID == kNIL) {
+				tail_ID = e.GetTailVertexID();
+			} else {
+				shape->push_back(e.GetPolylinePoint(0));
+			}
+			for(size_t k = 1; k <= e.GetNumShapePoints(); ++k) {
+				shape->push_back(e.GetPolylinePoint(k));
+			}
+			head_ID = e.GetHeadVertexID();
+			cost += e.GetCost(); demand += e.GetDemand();
+			service_cost += e.GetServiceCost(); service_cost_rev += e.GetReverseServiceCost();
+			deadhead_cost += e.GetDeadheadCost(); deadhead_cost_rev += e.GetReverseDeadheadCost();
+			service_demand += e.GetServiceDemand(); service_demand_rev += e.GetReverseServiceDemand();
+			deadhead_demand += e.GetDeadheadDemand(); deadhead_demand_rev += e.GetReverseDeadheadDemand();
+		}
+		Edge merged_edge(tail_ID, head_ID, kIsRequired, service_cost, service_cost_rev, deadhead_cost, deadhead_cost_rev);
+		merged_edge.SetCost(cost);
+		merged_edge.SetDemand(demand);
+		merged_edge.SetServiceDemands(service_demand, service_demand_rev);
+		merged_edge.SetDeadheadDemands(deadhead_demand, deadhead_demand_rev);
+		merged_edge.SetShape(shape);
+		return merged_edge;
+	}
+
+	int ContractShapeVertices(std::shared_ptr <Graph> &G, const std::vector <size_t> &kept_vertex_IDs) {
+		const size_t n = G->GetN(), m = G->GetM(), m_nr = G->GetMnr();
+		std::vector <size_t> degree(n, 0);
+		std::vector <std::array <size_t, 2>> shape_edges(n, {kNIL, kNIL});
+		for(size_t i = 0; i < m; ++i) {
+			size_t t, h;
+			G->GetVerticesIndexOfEdge(i, t, h, kIsRequired);
+			for(const size_t v:{t, h}) {
+				if(degree[v] < 2) {
+					shape_edges[v][degree[v]] = i;
+				}
+				++degree[v];
+			}
+		}
+		for(size_t i = 0; i < m_nr; ++i) {
+			size_t t, h;
+			G->GetVerticesIndexOfEdge(i, t, h, kIsNotRequired);
+			++degree[t]; ++degree[h];
+		}
+		std::vector <bool> is_shape(n, false);
+		for(size_t v = 0; v < n; ++v) {
+			/* A vertex whose only edge is a loop has degree two as well */
+			is_shape[v] = degree[v] == 2 and shape_edges[v][1] != kNIL and shape_edges[v][0] != shape_edges[v][1];
+		}
+		std::vector <size_t> depot_ids(kept_vertex_IDs);
+		if(G->IsMultipleDepotSet()) {
+			G->GetDepotsIDs(depot_ids);
+		}
+		if(G->IsDepotSet()) {
+			depot_ids.push_back(G->GetDepotID());
+		}
+		for(const auto &depot_id:depot_ids) {
+			size_t v;
+			if(G->GetVertexIndex(depot_id, v) == kSuccess) {
+				is_shape[v] = false;
+			}
+		}
+
+		std::vector <Edge> edge_list;
+		edge_list.reserve(m + m_nr);
+		std::vector <bool> is_visited(m, false);
+		ShapeChain chain;
+		auto contract_chain = [&](const size_t start, const size_t first_edge) {
+			const size_t end = WalkShapeChain(*G, start, first_edge, is_shape, shape_edges, is_visited, chain);
+			/* A chain that returns to its start would become a loop, so its last shape vertex is kept */
+			if(end == start and chain.size() > 1) {
+				ShapeChain last_link(1, chain.back());
+				chain.pop_back();
+				size_t t, h;
+				G->GetVerticesIndexOfEdge(last_link[0].first, t, h, kIsRequired);
+				is_shape[last_link[0].second ? h : t] = false;
+				edge_list.push_back(MergeShapeChain(*G, chain));
+				edge_list.push_back(MergeShapeChain(*G, last_link));
+				return;
+			}
+			edge_list.push_back(MergeShapeChain(*G, chain));
+		};
+		for(size_t i = 0; i < m; ++i) {
+			if(is_visited[i]) {
+				continue;
+			}
+			size_t t, h;
+			G->GetVerticesIndexOfEdge(i, t, h, kIsRequired);
+			if(not is_shape[t]) {
+				contract_chain(t, i);
+			} else if(not is_shape[h]) {
+				contract_chain(h, i);
+			}
+		}
+		/* The edges left form cycles of shape vertices */
+		for(size_t i = 0; i < m; ++i) {
+			if(is_visited[i]) {
+				continue;
+			}
+			size_t t, h;
+			G->GetVerticesIndexOfEdge(i, t, h, kIsRequired);
+			is_shape[t] = false;
+			contract_chain(t, i);
+		}
+		for(size_t i = 0; i < m_nr; ++i) {
+			edge_list.push_back(*G->GetEdge(i, kIsNotRequired));
+		}
+
+		std::vector <Vertex> vertex_list;
+		for(size_t v = 0; v < n; ++v) {
+			if(not is_shape[v]) {
+				vertex_list.push_back(*G->GetVertex(v));
+			}
+		}
+		auto contracted_G = std::make_shared <Graph>();
+		if(contracted_G->AssembleGraph(vertex_list, edge_list) == kFail) {
+			std::cerr << "Contraction of shape vertices failed\n";
+			return kFail;
+		}
+		contracted_G->SetCapacity(G->GetCapacity());
+		if(G->IsDepotSet()) {
+			contracted_G->SetDepot(G->GetDepotID());
+		}
+		if(G->IsMultipleDepotSet()) {
+			G->GetDepotsIDs(depot_ids);
+			contracted_G->AddDepots(depot_ids);
+		}
+		G = contracted_G;
+		return kSuccess;
+	}
+
 	int ComputeAllEdgeCosts(std::shared_ptr <Graph> &G, EdgeCost &edge_cost_computer) {
 		double cost, cost_rev;
 		size_t m = G->GetM();
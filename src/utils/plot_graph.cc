@@ -35,11 +35,14 @@ namespace lclibrary {
 		out_file.precision(16);
 		size_t m = G->GetM();
 		for(size_t i = 0; i < m; ++i) {
-			Vec2d tail_xy, head_xy;
-			G->GetVertexCoordinateofEdge(i, tail_xy, head_xy, true);
-			out_file << tail_xy.x << " " << tail_xy.y << " " << color << "\n";
-			out_file << head_xy.x << " " << head_xy.y << " " << color << "\n";
-			out_file <<"\n";
+			const Edge *e = G->GetEdge(i, true);
+			for(size_t k = 1; k < e->GetNumPolylinePoints(); ++k) {
+				auto tail_xy = e->GetPolylinePoint(k - 1).GetXY();
+				auto head_xy = e->GetPolylinePoint(k).GetXY();
+				out_file << tail_xy.x << " " << tail_xy.y << " " << color << "\n";
+				out_file << head_xy.x << " " << head_xy.y << " " << color << "\n";
+				out_file <<"\n";
+			}
 		}
 		out_file.close();
 	}
@@ -55,11 +58,14 @@ namespace lclibrary {
 		bool exists_flag = false;
 		for(size_t i = 0; i < m_nr; ++i) {
 			exists_flag = true;
-			Vec2d tail_xy, head_xy;
-			G->GetVertexCoordinateofEdge(i, tail_xy, head_xy, false);
-			out_file << tail_xy.x << " " << tail_xy.y << " " << color << "\n";
-			out_file << head_xy.x << " " << head_xy.y << " " << color << "\n";
-			out_file <<"\n";
+			const Edge *e = G->GetEdge(i, false);
+			for(size_t k = 1; k < e->GetNumPolylinePoints(); ++k) {
+				auto tail_xy = e->GetPolylinePoint(k - 1).GetXY();
+				auto head_xy = e->GetPolylinePoint(k).GetXY();
+				out_file << tail_xy.x << " " << tail_xy.y << " " << color << "\n";
+				out_file << head_xy.x << " " << head_xy.y << " " << color << "\n";
+				out_file <<"\n";
+			}
 		}
 		out_file.close();
 		return exists_flag;